@@ -1,3 +1,6 @@
+#include "thread_pool.hpp"
+
+#include <future>
 #include <iostream>
 #include <numeric>
 #include <thread>
@@ -27,16 +30,21 @@ int main(int argc, char **argv) {
   Job j2{1, d2};
   Job j3{2, d3};
 
-  auto t1 = std::thread(j1, 5);
-  auto t2 = std::thread(j2, 12);
-  auto t3 = std::thread(j3, 7);
+  // The jobs run on the persistent workers of the pool instead of a new
+  // thread per job. The pool has a worker for each job, because the jobs
+  // sleep most of the time.
+  ThreadPool pool(3);
+
+  std::future<void> f1 = pool.submit(j1, 5);
+  std::future<void> f2 = pool.submit(j2, 12);
+  std::future<void> f3 = pool.submit(j3, 7);
 
-  t1.join();
-  std::cout << "t1.join() done\n";
-  t2.join();
-  std::cout << "t2.join() done\n";
-  t3.join();
-  std::cout << "t3.join() done\n";
+  f1.get();
+  std::cout << "f1.get() done\n";
+  f2.get();
+  std::cout << "f2.get() done\n";
+  f3.get();
+  std::cout << "f3.get() done\n";
 
   return 0;
 }
@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
 #include <experimental/mdspan>
 #include <iostream>
 #include <ostream>
 #include <sstream>
+#include <vector>
 
 #include "utils.hpp"
 
@@ -181,6 +183,119 @@ void fullyLengthDynamic2DPrint(std::size_t y_size, std::size_t x_size) {
   std::cout << "<<<\n";
 }
 
+/// @brief Generates a 1D data set and a 2D MdSpan with layout_tiled. The
+/// function iterates tile by tile over all elements, which is the memory order
+/// of the layout, and stores the coordinate and the ordering of the access.
+/// Afterwards, each tile is visualized as a row. Tiles at the border are
+/// padded, if the extent is not a multiple of the tile size.
+/// @tparam TTileY Number of rows of a tile.
+/// @tparam TTileX Number of columns of a tile.
+/// @tparam y_size Height of the 2D matrix.
+/// @tparam x_size Width of the 2D matrix.
+template <std::size_t TTileY, std::size_t TTileX, auto y_size, auto x_size>
+void tiled2DPrint() {
+  using TLayout = layout_tiled<TTileY, TTileX>;
+  std::cout << ">>> print 2D array with full length static extent and layout "
+            << get_layout_name<TLayout>() << "\n";
+
+  std::size_t counter = 1;
+  using FullyStatic2DExtends = stdex::extents<std::size_t, y_size, x_size>;
+  typename TLayout::template mapping<FullyStatic2DExtends> mp{};
+
+  std::vector<Point2D> data(mp.required_span_size());
+  stdex::mdspan<Point2D, FullyStatic2DExtends, TLayout> m(data.data(), mp);
+
+  print_extend(m);
+  std::cout << "tile: " << TTileY << " x " << TTileX << "\n";
+  std::cout << "\n";
+
+  std::cout << "mp.is_always_unique(): " << std::boolalpha
+            << mp.is_always_unique() << "\n";
+  std::cout << "mp.is_always_strided(): " << std::boolalpha
+            << mp.is_always_strided() << "\n";
+  std::cout << "mp.is_always_exhaustive(): " << std::boolalpha
+            << mp.is_always_exhaustive() << "\n";
+  std::cout << "\n";
+
+  // The fast index is the x position in a tile, followed by the y position in
+  // a tile. Afterwards, the next tile of the row of tiles is used.
+  for (std::size_t tile_y = 0; tile_y < y_size; tile_y += TTileY) {
+    for (std::size_t tile_x = 0; tile_x < x_size; tile_x += TTileX) {
+      for (auto y = tile_y; y < std::min(tile_y + TTileY, y_size); ++y) {
+        for (auto x = tile_x; x < std::min(tile_x + TTileX, x_size); ++x) {
+          Point2D &point_ref = m[y, x];
+          point_ref.y = y;
+          point_ref.x = x;
+          point_ref.counter = counter++;
+        }
+      }
+    }
+  }
+
+  // visualize each tile as row
+  print2D(data, TTileY * TTileX, 3);
+
+  std::cout << "<<<\n";
+}
+
+/// @brief Check the 3D path of layout_tiled: each index is mapped to a
+/// different offset inside of required_span_size() (unique), all offsets are
+/// used only without padding (exhaustive) and the offsets of neighbours match
+/// stride(), if the mapping is strided.
+/// @tparam TTileY Number of rows of a tile.
+/// @tparam TTileX Number of columns of a tile.
+/// @param ext Extents of the 3D array.
+/// @param strided Expected result of is_strided().
+/// @return True, if all checks passed.
+template <std::size_t TTileY, std::size_t TTileX>
+bool checkTiled3D(stdex::dextents<std::size_t, 3> const &ext,
+                  bool const strided) {
+  using Extents3D = stdex::dextents<std::size_t, 3>;
+  using TLayout = layout_tiled<TTileY, TTileX>;
+  typename TLayout::template mapping<Extents3D> const mp(ext);
+
+  // write the number of each index through a 3D mdspan
+  std::vector<std::size_t> data(mp.required_span_size(), 0);
+  stdex::mdspan<std::size_t, Extents3D, TLayout> m(data.data(), mp);
+  std::vector<std::size_t> uses(data.size(), 0);
+  std::size_t counter = 1;
+  bool neighbours = true;
+  for (std::size_t z = 0; z < ext.extent(0); ++z) {
+    for (std::size_t y = 0; y < ext.extent(1); ++y) {
+      for (std::size_t x = 0; x < ext.extent(2); ++x) {
+        if (mp(z, y, x) >= data.size()) {
+          return false;
+        }
+        ++uses[mp(z, y, x)];
+        m[z, y, x] = counter++;
+        if (strided) {
+          neighbours &= z + 1 == ext.extent(0) ||
+                        mp(z + 1, y, x) - mp(z, y, x) == mp.stride(0);
+          neighbours &= y + 1 == ext.extent(1) ||
+                        mp(z, y + 1, x) - mp(z, y, x) == mp.stride(1);
+          neighbours &= x + 1 == ext.extent(2) ||
+                        mp(z, y, x + 1) - mp(z, y, x) == mp.stride(2);
+        }
+      }
+    }
+  }
+
+  bool unique = std::ranges::all_of(uses, [](auto u) { return u <= 1; });
+  counter = 1;
+  for (std::size_t z = 0; z < ext.extent(0); ++z) {
+    for (std::size_t y = 0; y < ext.extent(1); ++y) {
+      for (std::size_t x = 0; x < ext.extent(2); ++x) {
+        unique &= data[mp(z, y, x)] == counter++;
+      }
+    }
+  }
+  bool const exhaustive =
+      std::ranges::all_of(uses, [](auto u) { return u == 1; });
+
+  return unique && exhaustive == mp.is_exhaustive() &&
+         strided == mp.is_strided() && neighbours;
+}
+
 int main(int argc, char **argv) {
   std::size_t constexpr y_size = 5;
   std::size_t constexpr x_size = 9;
@@ -195,5 +310,23 @@ int main(int argc, char **argv) {
   fullyLengthDynamic2DPrint<stdex::layout_left>(y_size, x_size);
   std::cout << "\n";
 
-  return 0;
+  tiled2DPrint<2, 4, y_size, x_size>();
+  std::cout << "\n";
+
+  using Extents3D = stdex::dextents<std::size_t, 3>;
+  std::cout << ">>> check 3D layout_tiled mappings\n";
+  bool check = true;
+  check &= print_check("   3 x 5 x 9 with 2 x 4 tiles (padded)",
+                       checkTiled3D<2, 4>(Extents3D{3, 5, 9}, false));
+  check &= print_check("   2 x 4 x 8 with 2 x 4 tiles (exhaustive)",
+                       checkTiled3D<2, 4>(Extents3D{2, 4, 8}, false));
+  check &= print_check("   3 x 2 x 3 with 2 x 4 tiles (single tile)",
+                       checkTiled3D<2, 4>(Extents3D{3, 2, 3}, true));
+  check &= print_check("   2 x 3 x 9 with 1 x 4 tiles (single row)",
+                       checkTiled3D<1, 4>(Extents3D{2, 3, 9}, true));
+  check &= print_check("   2 x 3 x 4 with 1 x 1 tiles (layout_right)",
+                       checkTiled3D<1, 1>(Extents3D{2, 3, 4}, true));
+  std::cout << "<<<\n";
+
+  return check ? 0 : 1;
 }
@@ -1,10 +1,13 @@
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <experimental/mdspan>
 #include <iostream>
 #include <ostream>
+#include <span>
 #include <sstream>
 
+#include "padded_mdarray.hpp"
 #include "utils.hpp"
 
 namespace stdex = std::experimental;
@@ -27,7 +30,8 @@ std::ostream &operator<<(std::ostream &os, Point2D const &p) {
 /// @param indent Allows to ident the output by n whitespaces
 void print2D(std::ranges::random_access_range auto vec,
              std::integral auto slice, std::size_t const indent = 0) {
-  auto const rows = vec.size() / slice;
+  // the last row may be shorter than slice, e.g. without padding
+  auto const rows = (vec.size() + slice - 1) / slice;
 
   std::cout << "slice: " << slice << "\n";
   std::cout << "rows: " << rows << "\n";
@@ -40,7 +44,7 @@ void print2D(std::ranges::random_access_range auto vec,
 
   for (auto y = 0; y < rows; ++y) {
     std::cout << indent_str;
-    for (auto x = 0; x < slice; ++x) {
+    for (auto x = 0; x < slice && y * slice + x < vec.size(); ++x) {
       std::cout << vec[y * slice + x] << " ";
     }
     std::cout << std::endl;
@@ -108,12 +112,68 @@ void fullyLengthStatic2DPrint() {
   std::cout << "<<<\n";
 }
 
+/// @brief Same like fullyLengthStatic2DPrint(), but the padding is calculated
+/// by padded_mdarray, so that each row starts on a cache line.
+/// @tparam y_size Height of the 2D matrix.
+/// @tparam x_size Width of the 2D matrix.
+/// @return True, if each row of the padded_mdarray is aligned.
+template <auto y_size, auto x_size> bool autoPadded2DPrint() {
+  std::cout << ">>> print 2D padded_mdarray with full length static extent\n";
+
+  std::size_t counter = 1;
+  using FullyStatic2DExtends = stdex::extents<std::size_t, y_size, x_size>;
+
+  padded_mdarray<Point2D, FullyStatic2DExtends> array;
+  auto m = array.view();
+
+  print_extend(m);
+  std::cout << "row pitch: " << array.row_pitch() << " elements, "
+            << array.row_pitch() * sizeof(Point2D) << " bytes\n";
+  std::cout << "\n";
+
+  bool aligned = true;
+  for (auto y = 0; y < m.static_extent(0); ++y) {
+    aligned &= reinterpret_cast<std::uintptr_t>(&m[y, 0]) %
+                   array.alignment() ==
+               0;
+    for (auto x = 0; x < m.static_extent(1); ++x) {
+      Point2D &point_ref = m[y, x];
+      point_ref.y = y;
+      point_ref.x = x;
+      point_ref.counter = counter++;
+    }
+  }
+
+  print2D(std::span(array.data(), array.allocated_size()), array.row_pitch(),
+          3);
+  std::cout << "each row is " << (aligned ? "" : "not ") << "aligned to "
+            << array.alignment() << " bytes\n";
+
+  std::cout << "<<<\n";
+  return aligned;
+}
+
 int main(int argc, char **argv) {
   std::size_t constexpr y_size = 5;
   std::size_t constexpr x_size = 9;
   std::size_t constexpr x_padding = 2;
 
   fullyLengthStatic2DPrint<stdex::layout_right, y_size, x_size, x_padding>();
+  std::cout << "\n";
+
+  bool check = autoPadded2DPrint<y_size, x_size>();
+  std::cout << "\n";
 
-  return 0;
+  // a row of 1024 floats has 4 KiB, therefore padded_mdarray adds one cache
+  // line to avoid 4K aliasing
+  using Extents2D = stdex::dextents<std::size_t, 2>;
+  padded_mdarray<float, Extents2D> const aliasing(Extents2D{16, 1024});
+  padded_mdarray<float, Extents2D> const no_aliasing(Extents2D{16, 1024},
+                                                     false);
+  std::cout << "row pitch of 16 x 1024 floats: " << aliasing.row_pitch()
+            << " (avoid 4K aliasing), " << no_aliasing.row_pitch()
+            << " (allow 4K aliasing)\n";
+  check &= aliasing.row_pitch() == 1040 && no_aliasing.row_pitch() == 1024;
+
+  return check ? 0 : 1;
 }
@@ -0,0 +1,102 @@
+#include <cstddef>
+#include <experimental/mdspan>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "md_algorithm.hpp"
+#include "utils.hpp"
+
+namespace stdex = std::experimental;
+
+using Extents2D = stdex::dextents<std::size_t, 2>;
+
+int main(int argc, char **argv) {
+  std::size_t constexpr y_size = 3000;
+  std::size_t constexpr x_size = 1000;
+  std::size_t constexpr x_padding = 24;
+  bool check = true;
+
+  std::vector<int> data_right(y_size * x_size);
+  std::vector<int> data_left(y_size * x_size);
+  std::vector<int> data_padding(y_size * (x_size + x_padding), -1);
+
+  stdex::mdspan m_right(data_right.data(), Extents2D{y_size, x_size});
+  stdex::mdspan<int, Extents2D, stdex::layout_left> m_left(
+      data_left.data(), Extents2D{y_size, x_size});
+  stdex::mdspan m_padding(data_padding.data(),
+                          stdex::layout_stride::mapping<Extents2D>{
+                              Extents2D{y_size, x_size},
+                              std::array<std::size_t, 2>{x_size + x_padding,
+                                                         1}});
+
+  std::cout << ">>> md_fill\n";
+  // the sum of all elements does not fit in int
+  int constexpr value = 1000;
+  md_fill(m_padding, value);
+  long long const expected_sum =
+      static_cast<long long>(y_size) * x_size * value;
+  check &= print_check("md_fill(padded matrix)",
+                       md_reduce(m_padding) == expected_sum);
+  // the padding needs to be untouched
+  check &= print_check("padding is untouched",
+                       data_padding[x_size] == -1 &&
+                           data_padding[data_padding.size() - 1] == -1);
+  std::cout << "<<<\n\n";
+
+  std::cout << ">>> md_transform\n";
+  md_transform(m_padding, m_right, [](int const v) { return v / 10; });
+  md_transform(m_right, m_left, [](int const v) { return v + 1; });
+  check &= print_check("md_transform(padded matrix -> layout right)",
+                       md_reduce(m_right) ==
+                           static_cast<long long>(y_size) * x_size * 100);
+  check &= print_check("md_transform(layout right -> layout left)",
+                       md_reduce(m_left) ==
+                           static_cast<long long>(y_size) * x_size * 101);
+  std::cout << "<<<\n\n";
+
+  std::cout << ">>> md_copy\n";
+  for (std::size_t y = 0; y < y_size; ++y) {
+    for (std::size_t x = 0; x < x_size; ++x) {
+      m_right[y, x] = static_cast<int>(y * x_size + x);
+    }
+  }
+  md_copy(m_right, m_left);
+  check &= print_check("md_copy(layout right -> layout left)",
+                       is_equal(m_right, m_left));
+  md_copy(m_left, m_padding);
+  check &= print_check("md_copy(layout left -> padded matrix)",
+                       is_equal(m_left, m_padding));
+  check &= print_check("padding is untouched",
+                       data_padding[x_size] == -1 &&
+                           data_padding[data_padding.size() - 1] == -1);
+  std::cout << "<<<\n\n";
+
+  std::cout << ">>> md_transform_reduce\n";
+  // counts the elements with an even value
+  long long const even_elements = md_transform_reduce(
+      m_padding, 0LL, std::plus<>{},
+      [](int const v) { return (v % 2 == 0) ? 1LL : 0LL; });
+  check &= print_check("md_transform_reduce(padded matrix)",
+                       even_elements ==
+                           static_cast<long long>(y_size * x_size / 2));
+  std::cout << "<<<\n\n";
+
+  std::cout << ">>> runtime of the sum of a padded matrix\n";
+  md_fill(m_padding, 1);
+  long long const naive_sum = measure("nested loops with m[y, x]", [&]() {
+    long long sum = 0;
+    for (std::size_t y = 0; y < y_size; ++y) {
+      for (std::size_t x = 0; x < x_size; ++x) {
+        sum += m_padding[y, x];
+      }
+    }
+    return sum;
+  });
+  long long const md_sum =
+      measure("md_reduce", [&]() { return md_reduce(m_padding); });
+  check &= print_check("md_reduce", naive_sum == md_sum);
+  std::cout << "<<<\n";
+
+  return check ? 0 : 1;
+}
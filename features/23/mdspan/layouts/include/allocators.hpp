@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// ##########################################################################
+// Allocators for mdarray. All allocators return uninitialized memory and
+// satisfy the Allocator requirements of the standard library, therefore they
+// can be also used with std::vector.
+// ##########################################################################
+
+/// @brief Allocate memory with an alignment of TAlignment bytes, e.g. for
+/// aligned SIMD loads or to avoid false sharing between threads.
+/// @tparam T Element type.
+/// @tparam TAlignment Alignment in bytes. Needs to be a power of 2 and at least
+/// alignof(T).
+template <typename T, std::size_t TAlignment = 64> class AlignedAllocator {
+  static_assert((TAlignment & (TAlignment - 1)) == 0,
+                "TAlignment needs to be a power of 2");
+  static_assert(TAlignment >= alignof(T));
+
+public:
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, TAlignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(AlignedAllocator<U, TAlignment> const &) noexcept {}
+
+  T *allocate(std::size_t const n) {
+    return static_cast<T *>(
+        ::operator new(n * sizeof(T), std::align_val_t{TAlignment}));
+  }
+
+  void deallocate(T *ptr, std::size_t) noexcept {
+    ::operator delete(static_cast<void *>(ptr), std::align_val_t{TAlignment});
+  }
+
+  template <typename U>
+  bool operator==(AlignedAllocator<U, TAlignment> const &) const noexcept {
+    return true;
+  }
+};
+
+/// @brief Memory arena with a fixed size. Allocations are a pointer bump and
+/// single allocations are never freed. Instead, the whole arena is reset at
+/// once, e.g. after each time step of a simulation.
+class Arena {
+  std::unique_ptr<std::byte[]> m_memory;
+  std::size_t m_capacity;
+  std::size_t m_offset = 0;
+
+public:
+  explicit Arena(std::size_t const capacity)
+      : m_memory(new std::byte[capacity]), m_capacity(capacity) {}
+
+  /// @brief Return size bytes with the given alignment.
+  /// @throws std::bad_alloc, if the arena is exhausted.
+  void *allocate(std::size_t const size, std::size_t const alignment) {
+    std::size_t const begin =
+        (m_offset + alignment - 1) / alignment * alignment;
+    if (begin + size > m_capacity) {
+      throw std::bad_alloc{};
+    }
+    m_offset = begin + size;
+    return m_memory.get() + begin;
+  }
+
+  /// @brief Release all allocations. Memory of the arena, which is still used
+  /// afterwards, has undefined content.
+  void reset() { m_offset = 0; }
+
+  std::size_t used() const { return m_offset; }
+  std::size_t capacity() const { return m_capacity; }
+};
+
+/// @brief Allocate memory from an Arena. The allocator only stores a pointer
+/// to the arena, therefore the arena needs to outlive all allocations.
+template <typename T> class ArenaAllocator {
+  template <typename U> friend class ArenaAllocator;
+  Arena *m_arena;
+
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena &arena) noexcept : m_arena(&arena) {}
+  template <typename U>
+  ArenaAllocator(ArenaAllocator<U> const &other) noexcept
+      : m_arena(other.m_arena) {}
+
+  T *allocate(std::size_t const n) {
+    return static_cast<T *>(m_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  // memory is released by Arena::reset()
+  void deallocate(T *, std::size_t) noexcept {}
+
+  template <typename U>
+  bool operator==(ArenaAllocator<U> const &other) const noexcept {
+    return m_arena == other.m_arena;
+  }
+};
+
+#if defined(__linux__)
+
+/// @brief Map anonymous memory, which is not touched by the allocator.
+inline void *map_anonymous(std::size_t const size) {
+  void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED) {
+    throw std::bad_alloc{};
+  }
+  return ptr;
+}
+
+/// @brief Allocate memory with 2 MiB alignment and advise the kernel to back
+/// it with transparent huge pages. Huge pages reduce the number of TLB misses
+/// for large arrays, which are traversed with a large stride.
+template <typename T> class HugePageAllocator {
+public:
+  using value_type = T;
+
+  /// @brief Size of a transparent huge page on x86-64.
+  static std::size_t constexpr huge_page_size = std::size_t{2} << 20;
+
+  HugePageAllocator() = default;
+  template <typename U>
+  HugePageAllocator(HugePageAllocator<U> const &) noexcept {}
+
+  T *allocate(std::size_t const n) {
+    std::size_t const size = mapping_size(n);
+    // map one additional huge page and cut off the unaligned head and tail
+    auto *raw =
+        static_cast<std::byte *>(map_anonymous(size + huge_page_size));
+    auto const address = reinterpret_cast<std::uintptr_t>(raw);
+    std::size_t const head =
+        (huge_page_size - address % huge_page_size) % huge_page_size;
+    if (head > 0) {
+      munmap(raw, head);
+    }
+    munmap(raw + head + size, huge_page_size - head);
+    // the advice is only a hint, if THP is disabled the memory is still valid
+    madvise(raw + head, size, MADV_HUGEPAGE);
+    return reinterpret_cast<T *>(raw + head);
+  }
+
+  void deallocate(T *ptr, std::size_t const n) noexcept {
+    munmap(ptr, mapping_size(n));
+  }
+
+  template <typename U>
+  bool operator==(HugePageAllocator<U> const &) const noexcept {
+    return true;
+  }
+
+private:
+  static std::size_t mapping_size(std::size_t const n) {
+    std::size_t const size = std::max<std::size_t>(n * sizeof(T), 1);
+    return (size + huge_page_size - 1) / huge_page_size * huge_page_size;
+  }
+};
+
+/// @brief Allocate memory for NUMA systems without touching it. Linux places a
+/// page on the NUMA node of the thread, which writes it first (first touch
+/// policy). Together with a constructor of mdarray, which does not initialize
+/// the elements, and a parallel initialization (e.g. md_parallel_fill()), each
+/// thread gets the pages of its block on its local node. A std::vector would
+/// zero the whole memory from the allocating thread and place all pages on a
+/// single node.
+template <typename T> class NumaLocalAllocator {
+public:
+  using value_type = T;
+
+  NumaLocalAllocator() = default;
+  template <typename U>
+  NumaLocalAllocator(NumaLocalAllocator<U> const &) noexcept {}
+
+  T *allocate(std::size_t const n) {
+    return static_cast<T *>(
+        map_anonymous(std::max<std::size_t>(n * sizeof(T), 1)));
+  }
+
+  void deallocate(T *ptr, std::size_t const n) noexcept {
+    munmap(ptr, std::max<std::size_t>(n * sizeof(T), 1));
+  }
+
+  template <typename U>
+  bool operator==(NumaLocalAllocator<U> const &) const noexcept {
+    return true;
+  }
+};
+
+#endif
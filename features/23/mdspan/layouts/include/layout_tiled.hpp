@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <experimental/mdspan>
+#include <type_traits>
+
+/// @brief Layout policy, which stores 2D and 3D data in tiles of TTileY x
+/// TTileX elements. Each tile is contiguous in memory and stored like
+/// layout_right. The tiles of a plane are also stored like layout_right. For 3D
+/// data, the first dimension is the plane index and each plane is tiled.
+///
+/// If an extent is not a multiple of the tile size, the last tile of a row or
+/// column is padded. Therefore, the mapping is unique but not exhaustive.
+/// Because the distance between two neighbours depends on the position in the
+/// tile, the mapping is in general not strided. It is only strided, if the
+/// tiles degenerate, e.g. a single tile per plane or tiles of a single row.
+/// @tparam TTileY Number of rows of a tile.
+/// @tparam TTileX Number of columns of a tile.
+template <std::size_t TTileY, std::size_t TTileX> struct layout_tiled {
+  static_assert(TTileY > 0 && TTileX > 0, "a tile needs at least one element");
+
+  static std::size_t constexpr tile_y = TTileY;
+  static std::size_t constexpr tile_x = TTileX;
+  static std::size_t constexpr tile_size = TTileY * TTileX;
+
+  template <typename TExtents> class mapping {
+    static_assert(TExtents::rank() == 2 || TExtents::rank() == 3,
+                  "layout_tiled supports only 2D and 3D extents");
+
+  public:
+    using extents_type = TExtents;
+    using index_type = typename TExtents::index_type;
+    using size_type = typename TExtents::size_type;
+    using rank_type = typename TExtents::rank_type;
+    using layout_type = layout_tiled;
+
+  private:
+    static rank_type constexpr rank = TExtents::rank();
+    // dimension of y and x in the extents
+    static rank_type constexpr dim_y = rank - 2;
+    static rank_type constexpr dim_x = rank - 1;
+
+    extents_type m_extents{};
+
+    static constexpr index_type number_of_tiles(index_type const extent,
+                                                std::size_t const tile) {
+      return static_cast<index_type>((extent + tile - 1) / tile);
+    }
+
+    /// @brief Number of tiles in a row of tiles.
+    constexpr index_type tiles_per_row() const {
+      return number_of_tiles(m_extents.extent(dim_x), TTileX);
+    }
+
+    /// @brief Number of elements of a plane including the padding.
+    constexpr index_type plane_size() const {
+      return number_of_tiles(m_extents.extent(dim_y), TTileY) *
+             tiles_per_row() * static_cast<index_type>(tile_size);
+    }
+
+    constexpr index_type offset_2D(index_type const y,
+                                   index_type const x) const {
+      index_type const tile_index =
+          (y / TTileY) * tiles_per_row() + x / TTileX;
+      return tile_index * static_cast<index_type>(tile_size) +
+             (y % TTileY) * TTileX + x % TTileX;
+    }
+
+  public:
+    constexpr mapping() noexcept = default;
+    constexpr mapping(extents_type const &ext) noexcept : m_extents(ext) {}
+
+    constexpr extents_type const &extents() const noexcept {
+      return m_extents;
+    }
+
+    /// @brief Number of elements, which needs to be allocated. Includes the
+    /// padding of the tiles at the border.
+    constexpr index_type required_span_size() const noexcept {
+      for (rank_type r = 0; r < rank; ++r) {
+        if (m_extents.extent(r) == 0) {
+          return 0;
+        }
+      }
+      if constexpr (rank == 3) {
+        return m_extents.extent(0) * plane_size();
+      } else {
+        return plane_size();
+      }
+    }
+
+    template <typename... TIndex>
+      requires(sizeof...(TIndex) == rank &&
+               (std::is_convertible_v<TIndex, index_type> && ...))
+    constexpr index_type operator()(TIndex const... indices) const noexcept {
+      std::array<index_type, rank> const idx{
+          static_cast<index_type>(indices)...};
+      if constexpr (rank == 3) {
+        return idx[0] * plane_size() + offset_2D(idx[1], idx[2]);
+      } else {
+        return offset_2D(idx[0], idx[1]);
+      }
+    }
+
+    static constexpr bool is_always_unique() noexcept { return true; }
+    static constexpr bool is_always_exhaustive() noexcept { return false; }
+    static constexpr bool is_always_strided() noexcept { return false; }
+
+    constexpr bool is_unique() const noexcept { return true; }
+    /// @brief True, if the extents are multiples of the tile size, so that
+    /// there are no padding elements.
+    constexpr bool is_exhaustive() const noexcept {
+      return m_extents.extent(dim_y) % TTileY == 0 &&
+             m_extents.extent(dim_x) % TTileX == 0;
+    }
+    /// @brief True, if the distance between two neighbours in each dimension
+    /// does not depend on the position: in x, if a row has only one tile or a
+    /// tile has only one row or column, and in y, if a column has only one
+    /// tile, a tile has only one row or a row of tiles has only one tile.
+    constexpr bool is_strided() const noexcept {
+      bool const x_strided = m_extents.extent(dim_x) <= TTileX ||
+                             TTileX == 1 || TTileY == 1;
+      bool const y_strided = m_extents.extent(dim_y) <= TTileY ||
+                             TTileY == 1 || tiles_per_row() <= 1;
+      return x_strided && y_strided;
+    }
+
+    /// @brief Distance between two neighbours in dimension r.
+    /// @pre is_strided() is true, otherwise the distance depends on the
+    /// position and the result is only the distance at the index 0.
+    constexpr index_type stride(rank_type const r) const noexcept {
+      if (r == dim_x) {
+        return offset_2D(0, 1);
+      }
+      if (r == dim_y) {
+        return offset_2D(1, 0);
+      }
+      return plane_size();
+    }
+
+    friend constexpr bool operator==(mapping const &lhs,
+                                     mapping const &rhs) noexcept {
+      return lhs.extents() == rhs.extents();
+    }
+  };
+};
+
+/// @brief True, if TLayout is a layout_tiled.
+template <typename TLayout> struct is_layout_tiled : std::false_type {};
+
+template <std::size_t TTileY, std::size_t TTileX>
+struct is_layout_tiled<layout_tiled<TTileY, TTileX>> : std::true_type {};
+
+template <typename TLayout>
+inline bool constexpr is_layout_tiled_v = is_layout_tiled<TLayout>::value;
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <experimental/mdspan>
+#include <functional>
+#include <type_traits>
+
+#include "segment.hpp"
+#include "utils.hpp"
+
+/// @brief Accumulator type of md_reduce(). Integer sums are calculated with 64
+/// bit, so that the sum of many int values does not overflow. float sums are
+/// calculated with double.
+/// @tparam T Element type of the mdspan.
+template <typename T>
+using wide_accumulator_t = std::conditional_t<
+    std::is_floating_point_v<T>,
+    std::conditional_t<(sizeof(T) < sizeof(double)), double, T>,
+    std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+namespace detail {
+
+/// @brief Call func(in, in_stride, out, out_stride, length) for each run of
+/// two mdspans with the same extents. A run is a loop over the dimension with
+/// the smallest stride of out, because strided writes are more expensive than
+/// strided reads. All other dimensions are traversed in index order.
+template <typename TIn, typename TOut, typename TFunc>
+void for_each_run_pair(TIn in, TOut out, TFunc &&func) {
+  using index_type = typename TOut::index_type;
+  std::size_t constexpr rank = TOut::rank();
+
+  if constexpr (rank == 0) {
+    func(in.data_handle(), index_type{1}, out.data_handle(), index_type{1},
+         index_type{1});
+  } else {
+    if (out.size() == 0) {
+      return;
+    }
+
+    std::size_t inner = rank - 1;
+    for (std::size_t r = 0; r < rank; ++r) {
+      if (out.extent(r) > 1 &&
+          (out.extent(inner) == 1 || out.stride(r) < out.stride(inner))) {
+        inner = r;
+      }
+    }
+
+    std::array<index_type, rank> position{};
+    auto *in_data = in.data_handle();
+    auto *out_data = out.data_handle();
+    while (true) {
+      func(in_data, in.stride(inner), out_data, out.stride(inner),
+           out.extent(inner));
+
+      std::size_t d = rank;
+      for (; d > 0; --d) {
+        std::size_t const r = d - 1;
+        if (r == inner) {
+          continue;
+        }
+        in_data += in.stride(r);
+        out_data += out.stride(r);
+        if (++position[r] < out.extent(r)) {
+          break;
+        }
+        in_data -= in.stride(r) * out.extent(r);
+        out_data -= out.stride(r) * out.extent(r);
+        position[r] = 0;
+      }
+      if (d == 0) {
+        return;
+      }
+    }
+  }
+}
+
+/// @brief True, if both mdspans store the elements in the same order without
+/// gaps, so that they can be processed as a single run.
+template <typename TIn, typename TOut>
+bool is_same_contiguous_order(TIn const &in, TOut const &out) {
+  if constexpr (std::same_as<typename TIn::layout_type,
+                             typename TOut::layout_type> &&
+                MdspanLayoutContinuous<typename TIn::layout_type>) {
+    return true;
+  } else {
+    if (!in.is_exhaustive() || !out.is_exhaustive()) {
+      return false;
+    }
+    for (std::size_t r = 0; r < TOut::rank(); ++r) {
+      if (out.extent(r) > 1 && in.stride(r) != out.stride(r)) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+/// @brief Reduce a contiguous run with 4 independent accumulators, so that
+/// the compiler can vectorize the loop without reordering a single dependency
+/// chain.
+template <typename T, typename TAcc, typename TReduceOp, typename TTransformOp>
+TAcc transform_reduce_run(T const *data, std::size_t const length, TAcc init,
+                          TReduceOp &reduce_op, TTransformOp &transform_op) {
+  std::size_t constexpr lanes = 4;
+  std::size_t const vector_length = length - length % lanes;
+  if (vector_length > 0) {
+    std::array<TAcc, lanes> acc;
+    for (std::size_t l = 0; l < lanes; ++l) {
+      acc[l] = static_cast<TAcc>(transform_op(data[l]));
+    }
+    for (std::size_t i = lanes; i < vector_length; i += lanes) {
+      for (std::size_t l = 0; l < lanes; ++l) {
+        acc[l] = reduce_op(acc[l], static_cast<TAcc>(transform_op(data[i + l])));
+      }
+    }
+    init = reduce_op(init, reduce_op(reduce_op(acc[0], acc[1]),
+                                     reduce_op(acc[2], acc[3])));
+  }
+  for (std::size_t i = vector_length; i < length; ++i) {
+    init = reduce_op(init, static_cast<TAcc>(transform_op(data[i])));
+  }
+  return init;
+}
+
+} // namespace detail
+
+/// @brief Set all elements of a mdspan to value. Padding elements are not
+/// changed.
+/// @param m mdspan with data
+/// @param value New value of each element.
+template <typename TMdspan>
+  requires MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan>
+void md_fill(TMdspan m, typename TMdspan::value_type const &value) {
+  for_each_segment(m, [&value](auto *data, std::size_t const length) {
+    std::fill_n(data, length, value);
+  });
+}
+
+/// @brief Store op(in[i...]) in out[i...] for each multi dimensional index.
+/// The layouts of in and out can be different.
+/// @param in Input mdspan.
+/// @param out Output mdspan, needs to have the same extents like in.
+/// @param op Unary operation.
+template <typename TIn, typename TOut, typename TOp>
+  requires MdspanLayoutStrided<typename TIn::layout_type> &&
+           MdspanLayoutStrided<typename TOut::layout_type> &&
+           MdspanRawPointer<TIn> && MdspanRawPointer<TOut> &&
+           (TIn::rank() == TOut::rank())
+void md_transform(TIn in, TOut out, TOp op) {
+  assert(in.extents() == out.extents());
+
+  if (detail::is_same_contiguous_order(in, out)) {
+    std::transform(in.data_handle(), in.data_handle() + in.size(),
+                   out.data_handle(), op);
+    return;
+  }
+
+  detail::for_each_run_pair(
+      in, out,
+      [&op](auto const *in_data, std::size_t const in_stride, auto *out_data,
+            std::size_t const out_stride, std::size_t const length) {
+        if (in_stride == 1 && out_stride == 1) {
+          // contiguous loop, which can be vectorized
+          for (std::size_t i = 0; i < length; ++i) {
+            out_data[i] = op(in_data[i]);
+          }
+        } else {
+          for (std::size_t i = 0; i < length; ++i) {
+            out_data[i * out_stride] = op(in_data[i * in_stride]);
+          }
+        }
+      });
+}
+
+/// @brief Copy each element of in to the same multi dimensional index of out.
+/// If both mdspans have the same contiguous order, the memory is copied at
+/// once, otherwise each run is copied separately (e.g. layout_left to
+/// layout_right).
+/// @param in Input mdspan.
+/// @param out Output mdspan, needs to have the same extents like in.
+template <typename TIn, typename TOut>
+  requires MdspanLayoutStrided<typename TIn::layout_type> &&
+           MdspanLayoutStrided<typename TOut::layout_type> &&
+           MdspanRawPointer<TIn> && MdspanRawPointer<TOut> &&
+           (TIn::rank() == TOut::rank())
+void md_copy(TIn in, TOut out) {
+  assert(in.extents() == out.extents());
+
+  if (detail::is_same_contiguous_order(in, out)) {
+    std::copy_n(in.data_handle(), in.size(), out.data_handle());
+    return;
+  }
+
+  detail::for_each_run_pair(
+      in, out,
+      [](auto const *in_data, std::size_t const in_stride, auto *out_data,
+         std::size_t const out_stride, std::size_t const length) {
+        if (in_stride == 1 && out_stride == 1) {
+          std::copy_n(in_data, length, out_data);
+        } else {
+          for (std::size_t i = 0; i < length; ++i) {
+            out_data[i * out_stride] = in_data[i * in_stride];
+          }
+        }
+      });
+}
+
+/// @brief Transform each element and reduce all results. The elements are
+/// reduced segment-wise in memory order, therefore reduce_op needs to be
+/// associative and commutative. Padding elements are ignored.
+/// @param m mdspan with data
+/// @param init Initial value. Defines the accumulator type.
+/// @param reduce_op Binary operation, e.g. std::plus<>.
+/// @param transform_op Unary operation, which is applied on each element
+/// before the reduction.
+/// @return Reduced value.
+template <typename TMdspan, typename TAcc, typename TReduceOp,
+          typename TTransformOp>
+  requires MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan>
+TAcc md_transform_reduce(TMdspan m, TAcc init, TReduceOp reduce_op,
+                         TTransformOp transform_op) {
+  for_each_segment(m, [&](auto const *data, std::size_t const length) {
+    init = detail::transform_reduce_run(data, length, init, reduce_op,
+                                        transform_op);
+  });
+  return init;
+}
+
+/// @brief Sum all elements of a mdspan with wide_accumulator_t.
+/// @param m mdspan with data
+/// @return Sum of all elements.
+template <typename TMdspan>
+  requires MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan>
+wide_accumulator_t<typename TMdspan::value_type> md_reduce(TMdspan m) {
+  return md_transform_reduce(
+      m, wide_accumulator_t<typename TMdspan::value_type>{0}, std::plus<>{},
+      [](auto const &v) { return v; });
+}
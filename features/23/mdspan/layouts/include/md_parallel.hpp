@@ -0,0 +1,338 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <execution>
+#include <experimental/mdspan>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "md_algorithm.hpp"
+#include "utils.hpp"
+
+/// @brief Default number of blocks of the parallel algorithms. The number is
+/// independent of the number of threads, therefore the result of a reduction
+/// does not depend on the number of threads.
+inline std::size_t constexpr default_number_of_blocks = 256;
+
+namespace detail {
+
+/// @brief Return the dimensions ordered from the largest to the smallest
+/// stride (the first dimension is the outermost one for layout_right and the
+/// last one for layout_left).
+template <typename TMdspan>
+std::array<std::size_t, TMdspan::rank()> get_dims_by_stride(TMdspan const &m) {
+  std::array<std::size_t, TMdspan::rank()> dims;
+  std::iota(dims.begin(), dims.end(), std::size_t{0});
+  std::stable_sort(dims.begin(), dims.end(),
+                   [&m](std::size_t const a, std::size_t const b) {
+                     return m.stride(a) > m.stride(b);
+                   });
+  return dims;
+}
+
+/// @brief Static partitioning of a mdspan in blocks. The outer dimensions
+/// (largest strides) are collapsed to a single index space, until it has at
+/// least as many indices as requested blocks, and this index space is split in
+/// contiguous ranges. Therefore, also a mdspan with a short outermost
+/// dimension, e.g. a 2x1000x1000 tensor, is split in enough blocks.
+///
+/// A block consists of parts, which are layout_stride mdspans with the same
+/// strides like the original mdspan, therefore padding elements are not part
+/// of any block. If only one dimension is collapsed, each block has exactly
+/// one part.
+template <typename TMdspan> class MdspanBlocks {
+  using index_type = typename TMdspan::index_type;
+  static std::size_t constexpr rank = TMdspan::rank();
+  using extents_type = std::experimental::dextents<index_type, rank>;
+
+  TMdspan m_mdspan;
+  std::array<std::size_t, rank> m_dims;
+  // the first m_collapsed dimensions of m_dims are collapsed
+  std::size_t m_collapsed = 0;
+  // number of indices of the collapsed dimensions
+  std::size_t m_outer_size = 1;
+  std::size_t m_number_of_blocks = 0;
+
+public:
+  using part_type =
+      std::experimental::mdspan<typename TMdspan::element_type, extents_type,
+                                std::experimental::layout_stride>;
+
+  MdspanBlocks(TMdspan m, std::size_t const number_of_blocks)
+      : m_mdspan(m), m_dims(get_dims_by_stride(m)) {
+    if (m.size() == 0) {
+      return;
+    }
+    while (m_collapsed < rank && m_outer_size < number_of_blocks) {
+      m_outer_size *= m.extent(m_dims[m_collapsed++]);
+    }
+    m_number_of_blocks = std::min(number_of_blocks, m_outer_size);
+  }
+
+  std::size_t size() const { return m_number_of_blocks; }
+
+  /// @brief Call func(part) for each part of block b. The blocks differ at
+  /// most by one index of the collapsed dimensions. A part covers a range of
+  /// the innermost collapsed dimension, so a block has more than one part
+  /// only, if its range wraps around in this dimension.
+  template <typename TFunc>
+  void for_each_part(std::size_t const b, TFunc &&func) const {
+    std::size_t const begin = m_outer_size * b / m_number_of_blocks;
+    std::size_t const end = m_outer_size * (b + 1) / m_number_of_blocks;
+
+    std::array<index_type, rank> extents;
+    std::array<index_type, rank> strides;
+    for (std::size_t r = 0; r < rank; ++r) {
+      extents[r] = m_mdspan.extent(r);
+      strides[r] = m_mdspan.stride(r);
+    }
+    // index of begin in the collapsed dimensions, the others stay 0
+    std::array<index_type, rank> index{};
+    std::size_t rest = begin;
+    for (std::size_t c = m_collapsed; c > 0; --c) {
+      std::size_t const d = m_dims[c - 1];
+      index[d] = rest % extents[d];
+      rest /= extents[d];
+    }
+
+    std::size_t const inner = m_dims[m_collapsed - 1];
+    std::array<index_type, rank> part_extents = extents;
+    for (std::size_t c = 0; c < m_collapsed; ++c) {
+      part_extents[m_dims[c]] = 1;
+    }
+    for (std::size_t i = begin; i < end;) {
+      std::size_t const length =
+          std::min<std::size_t>(end - i, extents[inner] - index[inner]);
+      part_extents[inner] = length;
+      std::size_t offset = 0;
+      for (std::size_t c = 0; c < m_collapsed; ++c) {
+        offset += index[m_dims[c]] * strides[m_dims[c]];
+      }
+      func(part_type(m_mdspan.data_handle() + offset,
+                     std::experimental::layout_stride::mapping<extents_type>{
+                         extents_type{part_extents}, strides}));
+
+      i += length;
+      index[inner] += length;
+      for (std::size_t c = m_collapsed - 1;
+           c > 0 && index[m_dims[c]] == extents[m_dims[c]]; --c) {
+        index[m_dims[c]] = 0;
+        ++index[m_dims[c - 1]];
+      }
+    }
+  }
+};
+
+/// @brief Call func(b) for each block b. Thread t processes the contiguous
+/// range of blocks [t * blocks / threads, (t + 1) * blocks / threads).
+template <typename TFunc>
+void for_each_block(std::size_t const number_of_blocks,
+                    std::size_t const number_of_threads, TFunc const &func) {
+  std::size_t const threads =
+      std::max<std::size_t>(1, std::min(number_of_threads, number_of_blocks));
+  auto const worker = [&](std::size_t const t) {
+    for (std::size_t b = number_of_blocks * t / threads;
+         b < number_of_blocks * (t + 1) / threads; ++b) {
+      func(b);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  auto const join_all = [&workers]() {
+    for (std::thread &w : workers) {
+      w.join();
+    }
+  };
+  try {
+    for (std::size_t t = 1; t < threads; ++t) {
+      workers.emplace_back(worker, t);
+    }
+    // the calling thread is also a worker
+    worker(0);
+  } catch (...) {
+    // destroying a joinable std::thread calls std::terminate
+    join_all();
+    throw;
+  }
+  join_all();
+}
+
+/// @brief Same like the std::thread version, but the blocks are distributed
+/// by a parallel algorithm of the standard library.
+template <typename TExecutionPolicy, typename TFunc>
+void for_each_block(TExecutionPolicy &&policy,
+                    std::size_t const number_of_blocks, TFunc const &func) {
+  std::vector<std::size_t> blocks(number_of_blocks);
+  std::iota(blocks.begin(), blocks.end(), std::size_t{0});
+  std::for_each(std::forward<TExecutionPolicy>(policy), blocks.begin(),
+                blocks.end(), func);
+}
+
+/// @brief Transform and reduce all elements of a block. The first element
+/// initializes the result, so that no identity element is required.
+/// @return Reduced value or std::nullopt, if the block has no element.
+template <typename TAcc, typename TBlocks, typename TReduceOp,
+          typename TTransformOp>
+std::optional<TAcc> transform_reduce_block(TBlocks const &blocks,
+                                           std::size_t const b,
+                                           TReduceOp &reduce_op,
+                                           TTransformOp &transform_op) {
+  std::optional<TAcc> result;
+  blocks.for_each_part(b, [&](auto const &part) {
+    for_each_segment(part, [&](auto const *data, std::size_t length) {
+      if (!result) {
+        result = static_cast<TAcc>(transform_op(*data));
+        ++data;
+        --length;
+      }
+      *result = transform_reduce_run(data, length, *result, reduce_op,
+                                     transform_op);
+    });
+  });
+  return result;
+}
+
+/// @brief Reduce the partial results of the blocks in the order of the blocks.
+template <typename TAcc, typename TReduceOp>
+TAcc reduce_partial_results(
+    std::vector<std::optional<TAcc>> const &partial_results, TAcc init,
+    TReduceOp &reduce_op) {
+  for (std::optional<TAcc> const &partial_result : partial_results) {
+    if (partial_result) {
+      init = reduce_op(init, *partial_result);
+    }
+  }
+  return init;
+}
+
+} // namespace detail
+
+/// @brief Parallel version of md_fill(). The outer dimensions are split in
+/// blocks, which are distributed statically over the threads.
+/// @param m mdspan with data
+/// @param value New value of each element.
+/// @param number_of_threads Number of threads.
+template <typename TMdspan>
+  requires MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan>
+void md_parallel_fill(
+    TMdspan m, typename TMdspan::value_type const &value,
+    std::size_t const number_of_threads = std::thread::hardware_concurrency()) {
+  if constexpr (TMdspan::rank() == 0) {
+    md_fill(m, value);
+  } else {
+    detail::MdspanBlocks<TMdspan> const blocks(m, default_number_of_blocks);
+    detail::for_each_block(
+        blocks.size(), number_of_threads,
+        [&](std::size_t const b) {
+          blocks.for_each_part(
+              b, [&](auto const &part) { md_fill(part, value); });
+        });
+  }
+}
+
+/// @brief Parallel version of md_fill(), which uses a parallel algorithm of
+/// the standard library, e.g. with std::execution::par_unseq.
+/// @param policy Execution policy.
+/// @param m mdspan with data
+/// @param value New value of each element.
+template <typename TExecutionPolicy, typename TMdspan>
+  requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>> &&
+           MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan>
+void md_parallel_fill(TExecutionPolicy &&policy, TMdspan m,
+                      typename TMdspan::value_type const &value) {
+  if constexpr (TMdspan::rank() == 0) {
+    md_fill(m, value);
+  } else {
+    detail::MdspanBlocks<TMdspan> const blocks(m, default_number_of_blocks);
+    detail::for_each_block(
+        std::forward<TExecutionPolicy>(policy), blocks.size(),
+        [&](std::size_t const b) {
+          blocks.for_each_part(
+              b, [&](auto const &part) { md_fill(part, value); });
+        });
+  }
+}
+
+/// @brief Parallel version of md_transform_reduce(). Each block stores its
+/// partial result. Afterwards, the partial results are reduced in the order of
+/// the blocks. Because the blocks do not depend on the number of threads, the
+/// result is reproducible, also for floating point values. init is only used
+/// once.
+/// @param m mdspan with data
+/// @param init Initial value. Defines the accumulator type.
+/// @param reduce_op Binary operation, e.g. std::plus<>. Needs to be
+/// associative and commutative.
+/// @param transform_op Unary operation, which is applied on each element
+/// before the reduction.
+/// @param number_of_threads Number of threads.
+/// @return Reduced value.
+template <typename TMdspan, typename TAcc, typename TReduceOp,
+          typename TTransformOp>
+  requires MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan>
+TAcc md_parallel_transform_reduce(
+    TMdspan m, TAcc init, TReduceOp reduce_op, TTransformOp transform_op,
+    std::size_t const number_of_threads = std::thread::hardware_concurrency()) {
+  if constexpr (TMdspan::rank() == 0) {
+    return md_transform_reduce(m, init, reduce_op, transform_op);
+  } else {
+    detail::MdspanBlocks<TMdspan> const blocks(m, default_number_of_blocks);
+    std::vector<std::optional<TAcc>> partial_results(blocks.size());
+    detail::for_each_block(
+        blocks.size(), number_of_threads, [&](std::size_t const b) {
+          partial_results[b] = detail::transform_reduce_block<TAcc>(
+              blocks, b, reduce_op, transform_op);
+        });
+    return detail::reduce_partial_results(partial_results, init, reduce_op);
+  }
+}
+
+/// @brief Parallel version of md_transform_reduce(), which uses a parallel
+/// algorithm of the standard library, e.g. with std::execution::par_unseq.
+/// Gives the same result like the std::thread version.
+template <typename TExecutionPolicy, typename TMdspan, typename TAcc,
+          typename TReduceOp, typename TTransformOp>
+  requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>> &&
+           MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan>
+TAcc md_parallel_transform_reduce(TExecutionPolicy &&policy, TMdspan m,
+                                  TAcc init, TReduceOp reduce_op,
+                                  TTransformOp transform_op) {
+  if constexpr (TMdspan::rank() == 0) {
+    return md_transform_reduce(m, init, reduce_op, transform_op);
+  } else {
+    detail::MdspanBlocks<TMdspan> const blocks(m, default_number_of_blocks);
+    std::vector<std::optional<TAcc>> partial_results(blocks.size());
+    detail::for_each_block(
+        std::forward<TExecutionPolicy>(policy), blocks.size(),
+        [&](std::size_t const b) {
+          partial_results[b] = detail::transform_reduce_block<TAcc>(
+              blocks, b, reduce_op, transform_op);
+        });
+    return detail::reduce_partial_results(partial_results, init, reduce_op);
+  }
+}
+
+/// @brief Parallel version of md_reduce().
+/// @param m mdspan with data
+/// @param number_of_threads Number of threads.
+/// @return Sum of all elements.
+template <typename TMdspan>
+  requires MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan>
+wide_accumulator_t<typename TMdspan::value_type> md_parallel_reduce(
+    TMdspan m,
+    std::size_t const number_of_threads = std::thread::hardware_concurrency()) {
+  return md_parallel_transform_reduce(
+      m, wide_accumulator_t<typename TMdspan::value_type>{0}, std::plus<>{},
+      [](auto const &v) { return v; }, number_of_threads);
+}
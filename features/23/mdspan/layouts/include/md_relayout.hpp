@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <experimental/mdspan>
+#include <utility>
+
+#include "md_algorithm.hpp"
+#include "utils.hpp"
+
+/// @brief Default edge length of the tiles of md_relayout() and
+/// md_transpose_inplace(). A tile of 32 x 32 float or double values uses 4 KiB
+/// or 8 KiB and the input and the output tile fit in the L1 cache.
+inline std::size_t constexpr default_relayout_tile_size = 32;
+
+namespace detail {
+
+/// @brief Return the dimension with the smallest stride, which has more than
+/// one element.
+template <typename TMdspan> std::size_t get_fastest_dim(TMdspan const &m) {
+  std::size_t fastest = TMdspan::rank() - 1;
+  for (std::size_t r = 0; r < TMdspan::rank(); ++r) {
+    if (m.extent(r) > 1 &&
+        (m.extent(fastest) <= 1 || m.stride(r) < m.stride(fastest))) {
+      fastest = r;
+    }
+  }
+  return fastest;
+}
+
+/// @brief Copy a 2D tile. The inner loop writes contiguous along the fast
+/// dimension of out, the reads are strided but the tile stays in the cache.
+template <typename TIn, typename TOut>
+void copy_tile(TIn const *in, std::size_t const in_stride_a,
+               std::size_t const in_stride_b, TOut *out,
+               std::size_t const out_stride_a, std::size_t const out_stride_b,
+               std::size_t const length_a, std::size_t const length_b) {
+  for (std::size_t a = 0; a < length_a; ++a) {
+    for (std::size_t b = 0; b < length_b; ++b) {
+      out[a * out_stride_a + b * out_stride_b] =
+          in[a * in_stride_a + b * in_stride_b];
+    }
+  }
+}
+
+} // namespace detail
+
+/// @brief Copy each element of in to the same multi dimensional index of out,
+/// where in and out have a different fast dimension, e.g. layout_right to
+/// layout_left. A naive loop nest reads or writes with a large stride, which
+/// loads a complete cache line for each element. Therefore, the two fast
+/// dimensions are copied in tiles of tile_size x tile_size elements. All other
+/// dimensions are traversed with an outer loop. If in and out have the same
+/// fast dimension, md_copy() is used.
+/// @param in Input mdspan.
+/// @param out Output mdspan, needs to have the same extents like in.
+/// @param tile_size Edge length of a tile.
+template <typename TIn, typename TOut>
+  requires MdspanLayoutStrided<typename TIn::layout_type> &&
+           MdspanLayoutStrided<typename TOut::layout_type> &&
+           MdspanRawPointer<TIn> && MdspanRawPointer<TOut> &&
+           (TIn::rank() == TOut::rank())
+void md_relayout(TIn in, TOut out,
+                 std::size_t const tile_size = default_relayout_tile_size) {
+  assert(in.extents() == out.extents());
+  using index_type = typename TOut::index_type;
+  std::size_t constexpr rank = TOut::rank();
+
+  if constexpr (rank < 2) {
+    md_copy(in, out);
+  } else {
+    // a: fast dimension of in, b: fast dimension of out
+    std::size_t const a = detail::get_fastest_dim(in);
+    std::size_t const b = detail::get_fastest_dim(out);
+    if (a == b || out.size() == 0) {
+      md_copy(in, out);
+      return;
+    }
+
+    index_type const extent_a = out.extent(a);
+    index_type const extent_b = out.extent(b);
+
+    // odometer over the other dimensions
+    std::array<index_type, rank> position{};
+    auto const *in_data = in.data_handle();
+    auto *out_data = out.data_handle();
+    while (true) {
+      for (index_type tile_a = 0; tile_a < extent_a; tile_a += tile_size) {
+        for (index_type tile_b = 0; tile_b < extent_b; tile_b += tile_size) {
+          detail::copy_tile(
+              in_data + tile_a * in.stride(a) + tile_b * in.stride(b),
+              in.stride(a), in.stride(b),
+              out_data + tile_a * out.stride(a) + tile_b * out.stride(b),
+              out.stride(a), out.stride(b),
+              std::min<index_type>(tile_size, extent_a - tile_a),
+              std::min<index_type>(tile_size, extent_b - tile_b));
+        }
+      }
+
+      std::size_t d = rank;
+      for (; d > 0; --d) {
+        std::size_t const r = d - 1;
+        if (r == a || r == b) {
+          continue;
+        }
+        in_data += in.stride(r);
+        out_data += out.stride(r);
+        if (++position[r] < out.extent(r)) {
+          break;
+        }
+        in_data -= in.stride(r) * out.extent(r);
+        out_data -= out.stride(r) * out.extent(r);
+        position[r] = 0;
+      }
+      if (d == 0) {
+        return;
+      }
+    }
+  }
+}
+
+/// @brief Transpose a square matrix in place: m[y, x] becomes m[x, y]. The
+/// matrix is processed in pairs of tiles, which are mirrored at the diagonal,
+/// so that both tiles stay in the cache during the swap.
+/// @param m Square 2D mdspan.
+/// @param tile_size Edge length of a tile.
+template <typename TMdspan>
+  requires MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan> && (TMdspan::rank() == 2)
+void md_transpose_inplace(
+    TMdspan m, std::size_t const tile_size = default_relayout_tile_size) {
+  assert(m.extent(0) == m.extent(1) && "The matrix needs to be square.");
+  using index_type = typename TMdspan::index_type;
+  index_type const n = m.extent(0);
+  index_type const stride_y = m.stride(0);
+  index_type const stride_x = m.stride(1);
+  auto *data = m.data_handle();
+
+  for (index_type tile_y = 0; tile_y < n; tile_y += tile_size) {
+    index_type const end_y = std::min<index_type>(tile_y + tile_size, n);
+    for (index_type tile_x = tile_y; tile_x < n; tile_x += tile_size) {
+      index_type const end_x = std::min<index_type>(tile_x + tile_size, n);
+      for (index_type y = tile_y; y < end_y; ++y) {
+        // on the diagonal tile, only swap the elements above the diagonal
+        index_type const begin_x = (tile_x == tile_y) ? y + 1 : tile_x;
+        for (index_type x = begin_x; x < end_x; ++x) {
+          std::swap(data[y * stride_y + x * stride_x],
+                    data[x * stride_y + y * stride_x]);
+        }
+      }
+    }
+  }
+}
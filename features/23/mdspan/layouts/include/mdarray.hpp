@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <experimental/mdspan>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/// @brief Owning multi dimensional array. The memory is allocated with
+/// TAllocator and the layout mapping defines the size of the allocation and
+/// the access. view() returns a non-owning mdspan of the data, which is only a
+/// pointer and the mapping and can be passed by value to all algorithms of
+/// this folder.
+///
+/// In contrast to std::vector, the constructor without an initial value does
+/// not initialize the elements of trivially default constructible types. This
+/// avoids writing large buffers twice, if they are overwritten anyway, and
+/// allows a first touch placement of the pages on NUMA systems. Other types
+/// are default constructed.
+/// @tparam T Element type.
+/// @tparam TExtents std::experimental::extents type.
+/// @tparam TLayout Layout policy, e.g. std::experimental::layout_right.
+/// @tparam TAllocator Allocator, e.g. AlignedAllocator or ArenaAllocator.
+template <typename T, typename TExtents,
+          typename TLayout = std::experimental::layout_right,
+          typename TAllocator = std::allocator<T>>
+class mdarray {
+  using alloc_traits = std::allocator_traits<TAllocator>;
+
+public:
+  using element_type = T;
+  using value_type = T;
+  using extents_type = TExtents;
+  using layout_type = TLayout;
+  using allocator_type = TAllocator;
+  using index_type = typename TExtents::index_type;
+  using mapping_type = typename TLayout::template mapping<TExtents>;
+  using mdspan_type = std::experimental::mdspan<T, TExtents, TLayout>;
+  using const_mdspan_type =
+      std::experimental::mdspan<T const, TExtents, TLayout>;
+
+private:
+  mapping_type m_mapping;
+  TAllocator m_allocator;
+  T *m_data = nullptr;
+  std::size_t m_size = 0;
+
+  /// @brief Allocate the memory and construct the elements with
+  /// construct(m_data, m_size). The destructor is not called, if a constructor
+  /// throws, therefore the memory is released here before the exception is
+  /// rethrown. The std::uninitialized_* algorithms already destroy the
+  /// elements, which they have constructed.
+  template <typename TConstruct> void allocate(TConstruct &&construct) {
+    m_size = static_cast<std::size_t>(m_mapping.required_span_size());
+    m_data = alloc_traits::allocate(m_allocator, m_size);
+    try {
+      construct(m_data, m_size);
+    } catch (...) {
+      alloc_traits::deallocate(m_allocator, m_data, m_size);
+      m_data = nullptr;
+      m_size = 0;
+      throw;
+    }
+  }
+
+  void release() noexcept {
+    if (m_data != nullptr) {
+      std::destroy_n(m_data, m_size);
+      alloc_traits::deallocate(m_allocator, m_data, m_size);
+      m_data = nullptr;
+      m_size = 0;
+    }
+  }
+
+public:
+  /// @brief Allocate the array without initializing trivially default
+  /// constructible elements.
+  /// @param mapping Layout mapping, e.g. with padding for layout_stride.
+  /// @param allocator Allocator instance, e.g. with a reference to an Arena.
+  explicit mdarray(mapping_type const &mapping,
+                   TAllocator const &allocator = TAllocator())
+      : m_mapping(mapping), m_allocator(allocator) {
+    allocate([](T *data, std::size_t const size) {
+      std::uninitialized_default_construct_n(data, size);
+    });
+  }
+
+  /// @brief Allocate the array and set each element to value, including the
+  /// elements, which are not part of the index space (e.g. padding).
+  mdarray(mapping_type const &mapping, T const &value,
+          TAllocator const &allocator = TAllocator())
+      : m_mapping(mapping), m_allocator(allocator) {
+    allocate([&value](T *data, std::size_t const size) {
+      std::uninitialized_fill_n(data, size, value);
+    });
+  }
+
+  /// @brief Allocate the array without initializing trivially default
+  /// constructible elements.
+  explicit mdarray(extents_type const &ext = extents_type{},
+                   TAllocator const &allocator = TAllocator())
+      : mdarray(mapping_type(ext), allocator) {}
+
+  /// @brief Allocate the array and set each element to value.
+  mdarray(extents_type const &ext, T const &value,
+          TAllocator const &allocator = TAllocator())
+      : mdarray(mapping_type(ext), value, allocator) {}
+
+  mdarray(mdarray const &other)
+      : m_mapping(other.m_mapping),
+        m_allocator(alloc_traits::select_on_container_copy_construction(
+            other.m_allocator)) {
+    allocate([&other](T *data, std::size_t const size) {
+      std::uninitialized_copy_n(other.m_data, size, data);
+    });
+  }
+
+  mdarray(mdarray &&other) noexcept
+      : m_mapping(other.m_mapping), m_allocator(std::move(other.m_allocator)),
+        m_data(std::exchange(other.m_data, nullptr)),
+        m_size(std::exchange(other.m_size, 0)) {}
+
+  mdarray &operator=(mdarray const &other) {
+    if (this != &other) {
+      mdarray copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  mdarray &operator=(mdarray &&other) noexcept {
+    if (this != &other) {
+      release();
+      m_mapping = other.m_mapping;
+      m_allocator = std::move(other.m_allocator);
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+  }
+
+  ~mdarray() { release(); }
+
+  void swap(mdarray &other) noexcept {
+    std::swap(m_mapping, other.m_mapping);
+    std::swap(m_allocator, other.m_allocator);
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+  }
+
+  /// @brief Return a non-owning view. The view is invalidated, if the mdarray
+  /// is destroyed or moved to.
+  mdspan_type view() { return mdspan_type(m_data, m_mapping); }
+  const_mdspan_type view() const {
+    return const_mdspan_type(m_data, m_mapping);
+  }
+
+  operator mdspan_type() { return view(); }
+  operator const_mdspan_type() const { return view(); }
+
+  template <typename... TIndex>
+    requires(sizeof...(TIndex) == TExtents::rank())
+  T &operator[](TIndex const... indices) {
+    return m_data[m_mapping(static_cast<index_type>(indices)...)];
+  }
+
+  template <typename... TIndex>
+    requires(sizeof...(TIndex) == TExtents::rank())
+  T const &operator[](TIndex const... indices) const {
+    return m_data[m_mapping(static_cast<index_type>(indices)...)];
+  }
+
+  mapping_type const &mapping() const { return m_mapping; }
+  extents_type const &extents() const { return m_mapping.extents(); }
+  index_type extent(std::size_t const r) const {
+    return m_mapping.extents().extent(r);
+  }
+  static constexpr std::size_t rank() { return TExtents::rank(); }
+
+  /// @brief Number of elements of the multi dimensional index space.
+  std::size_t size() const {
+    std::size_t size = 1;
+    for (std::size_t r = 0; r < rank(); ++r) {
+      size *= extent(r);
+    }
+    return size;
+  }
+
+  /// @brief Pointer to the allocated memory with required_span_size()
+  /// elements.
+  T *data() { return m_data; }
+  T const *data() const { return m_data; }
+
+  TAllocator get_allocator() const { return m_allocator; }
+};
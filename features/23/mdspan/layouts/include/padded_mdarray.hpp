@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <experimental/mdspan>
+#include <numeric>
+
+#include "allocators.hpp"
+#include "mdarray.hpp"
+
+/// @brief Default alignment of each row of a padded_mdarray in bytes. It is
+/// the size of a cache line and of an AVX-512 register.
+inline std::size_t constexpr default_row_alignment = 64;
+
+/// @brief If the distance between two rows is a multiple of the page size, the
+/// same column of consecutive rows maps to the same cache set (4K aliasing).
+inline std::size_t constexpr aliasing_distance = 4096;
+
+/// @brief Calculate the distance between the first elements of two rows in
+/// bytes. The pitch is a multiple of the alignment and of sizeof(T), so that
+/// each row starts on an aligned address.
+/// @param row_bytes Size of the elements of a row in bytes.
+/// @param element_size sizeof(T)
+/// @param alignment Alignment of each row in bytes. Needs to be a power of 2.
+/// @param avoid_aliasing If true, the pitch is increased by one alignment
+/// step, if it is a multiple of aliasing_distance.
+/// @return Row pitch in bytes.
+constexpr std::size_t calculate_row_pitch(std::size_t const row_bytes,
+                                          std::size_t const element_size,
+                                          std::size_t const alignment,
+                                          bool const avoid_aliasing) {
+  std::size_t const step = std::lcm(alignment, element_size);
+  std::size_t pitch = (row_bytes + step - 1) / step * step;
+  if (avoid_aliasing && pitch > 0 && pitch % aliasing_distance == 0) {
+    pitch += step;
+  }
+  return pitch;
+}
+
+static_assert(calculate_row_pitch(9 * 4, 4, 64, true) == 64);
+static_assert(calculate_row_pitch(1024 * 4, 4, 64, false) == 4096);
+static_assert(calculate_row_pitch(1024 * 4, 4, 64, true) == 4160);
+static_assert(calculate_row_pitch(9 * 24, 24, 64, true) == 384);
+
+/// @brief Owning multi dimensional array, where each row (the last dimension)
+/// starts on an aligned address. It is a mdarray with a layout_stride mapping,
+/// which skips the padding at the end of each row, and an AlignedAllocator
+/// with the alignment of the rows. All other dimensions are stored like
+/// layout_right. Like mdarray, the constructor without an initial value does
+/// not initialize trivially default constructible elements.
+/// @tparam T Element type.
+/// @tparam TExtents std::experimental::extents type.
+/// @tparam TAlignment Alignment of each row in bytes. Needs to be a power of 2
+/// and at least alignof(T).
+template <typename T, typename TExtents,
+          std::size_t TAlignment = default_row_alignment>
+class padded_mdarray
+    : public mdarray<T, TExtents, std::experimental::layout_stride,
+                     AlignedAllocator<T, TAlignment>> {
+  using base_type = mdarray<T, TExtents, std::experimental::layout_stride,
+                            AlignedAllocator<T, TAlignment>>;
+  static std::size_t constexpr rank = TExtents::rank();
+
+public:
+  using typename base_type::extents_type;
+  using typename base_type::index_type;
+  using typename base_type::mapping_type;
+
+  /// @brief Create the layout_stride mapping with the padded row pitch.
+  /// @param ext Extents of the array.
+  /// @param avoid_aliasing If true, the row pitch is never a multiple of 4 KiB.
+  static mapping_type create_mapping(extents_type const &ext,
+                                     bool const avoid_aliasing = true) {
+    std::array<index_type, rank> strides{};
+    if constexpr (rank > 0) {
+      strides[rank - 1] = 1;
+      if constexpr (rank > 1) {
+        strides[rank - 2] = static_cast<index_type>(
+            calculate_row_pitch(ext.extent(rank - 1) * sizeof(T), sizeof(T),
+                                TAlignment, avoid_aliasing) /
+            sizeof(T));
+        for (std::size_t r = rank - 2; r > 0; --r) {
+          strides[r - 1] = strides[r] * ext.extent(r);
+        }
+      }
+    }
+    return mapping_type(ext, strides);
+  }
+
+  /// @brief Allocate the array without initializing trivially default
+  /// constructible elements.
+  /// @param ext Extents of the array.
+  /// @param avoid_aliasing If true, the row pitch is never a multiple of 4 KiB.
+  explicit padded_mdarray(extents_type const &ext = extents_type{},
+                          bool const avoid_aliasing = true)
+      : base_type(create_mapping(ext, avoid_aliasing)) {}
+
+  /// @brief Allocate the array and set each element to value, including the
+  /// padding elements.
+  padded_mdarray(extents_type const &ext, T const &value,
+                 bool const avoid_aliasing = true)
+      : base_type(create_mapping(ext, avoid_aliasing), value) {}
+
+  /// @brief Distance between two rows in elements.
+  index_type row_pitch() const {
+    if constexpr (rank > 1) {
+      return this->mapping().stride(rank - 2);
+    } else if constexpr (rank == 1) {
+      return this->extent(0);
+    } else {
+      return 1;
+    }
+  }
+
+  static constexpr std::size_t alignment() { return TAlignment; }
+
+  /// @brief Number of allocated elements including the padding elements
+  /// between the rows. The last row has no padding.
+  std::size_t allocated_size() const {
+    return static_cast<std::size_t>(this->mapping().required_span_size());
+  }
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <experimental/mdspan>
+#include <type_traits>
+
+#include "utils.hpp"
+
+/// @brief mdspan, which points to raw memory, so that a segment can be passed
+/// as pointer and length, e.g. to memcpy or a SIMD loop.
+template <typename TMdspan>
+concept MdspanRawPointer =
+    std::same_as<typename TMdspan::data_handle_type,
+                 typename TMdspan::element_type *>;
+
+namespace detail {
+
+/// @brief Extent and stride of a dimension, which is traversed by
+/// for_each_segment().
+template <typename TIndex> struct SegmentDim {
+  TIndex extent;
+  TIndex stride;
+};
+
+/// @brief Sort the dimensions by stride and merge each pair of dimensions,
+/// where the outer dimension jumps exactly over the inner dimension. The
+/// result is the shortest loop nest over the memory of the mdspan.
+/// @param dims Extent and stride of each dimension. Is overwritten with the
+/// merged dimensions, the innermost dimension is stored first.
+/// @return Number of merged dimensions. 0, if the mdspan has no element.
+template <typename TIndex, std::size_t TRank>
+std::size_t collapse_dims(std::array<SegmentDim<TIndex>, TRank> &dims) {
+  if (std::any_of(dims.begin(), dims.end(),
+                  [](auto const &d) { return d.extent == 0; })) {
+    return 0;
+  }
+
+  // dimensions with a single element do not contribute to the loop nest
+  auto const end = std::remove_if(dims.begin(), dims.end(),
+                                  [](auto const &d) { return d.extent == 1; });
+  std::sort(dims.begin(), end,
+            [](auto const &a, auto const &b) { return a.stride < b.stride; });
+
+  std::size_t merged = 0;
+  for (auto it = dims.begin(); it != end; ++it) {
+    if (merged > 0 && it->stride == dims[merged - 1].stride *
+                                         dims[merged - 1].extent) {
+      dims[merged - 1].extent *= it->extent;
+    } else {
+      dims[merged++] = *it;
+    }
+  }
+  // a scalar or a mdspan with only extents of 1 is a single element
+  if (merged == 0) {
+    dims[0] = {1, 1};
+    merged = 1;
+  }
+  return merged;
+}
+
+} // namespace detail
+
+/// @brief Decompose a mdspan into maximal contiguous runs of memory and call
+/// func(T *, length) for each run. Dimensions, which are contiguous to each
+/// other (e.g. all dimensions of layout_right or a padded layout_stride without
+/// padding in the outer dimensions), are merged to a single run. The runs are
+/// visited in memory order, which is the index order for layout_right but not
+/// for layout_left or transposed strides.
+///
+/// For layout_left and layout_right, the whole mdspan is a single run.
+/// @tparam TMdspan mdspan with a layout of MdspanLayoutStrided and a raw
+/// pointer as data handle.
+/// @param m mdspan with data
+/// @param func Function, which is called with the pointer to the first element
+/// and the number of elements of each run.
+template <typename TMdspan, typename TFunc>
+  requires MdspanLayoutStrided<typename TMdspan::layout_type> &&
+           MdspanRawPointer<TMdspan>
+void for_each_segment(TMdspan m, TFunc &&func) {
+  using index_type = typename TMdspan::index_type;
+
+  if constexpr (MdspanLayoutContinuous<typename TMdspan::layout_type>) {
+    if (m.size() > 0) {
+      func(m.data_handle(), static_cast<index_type>(m.size()));
+    }
+  } else {
+    std::size_t constexpr rank = TMdspan::rank();
+    if constexpr (rank == 0) {
+      func(m.data_handle(), index_type{1});
+    } else {
+      std::array<detail::SegmentDim<index_type>, rank> dims;
+      for (std::size_t r = 0; r < rank; ++r) {
+        dims[r] = {m.extent(r), m.stride(r)};
+      }
+      std::size_t const loop_dims = detail::collapse_dims(dims);
+      if (loop_dims == 0) {
+        return;
+      }
+
+      // if the innermost dimension is not contiguous, each element is a run
+      bool const contiguous = dims[0].stride == 1;
+      index_type const run_length = contiguous ? dims[0].extent : 1;
+      std::size_t const outer_begin = contiguous ? 1 : 0;
+
+      // odometer over the outer dimensions
+      std::array<index_type, rank> position{};
+      typename TMdspan::element_type *data = m.data_handle();
+      while (true) {
+        func(data, run_length);
+
+        std::size_t d = outer_begin;
+        for (; d < loop_dims; ++d) {
+          data += dims[d].stride;
+          if (++position[d] < dims[d].extent) {
+            break;
+          }
+          data -= dims[d].stride * dims[d].extent;
+          position[d] = 0;
+        }
+        if (d == loop_dims) {
+          return;
+        }
+      }
+    }
+  }
+}
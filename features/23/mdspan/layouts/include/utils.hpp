@@ -1,7 +1,16 @@
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <experimental/mdspan>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "layout_tiled.hpp"
 
 /// @brief Print the size of the extent and if it is static or dynamic.
 /// @tparam TMdspan Type of the MdSpan with extent.
@@ -46,10 +55,18 @@ template <typename TLayout>
 concept MdspanLayoutStride =
     (std::same_as<TLayout, std::experimental::layout_stride>);
 
+/// @brief Layouts, which provide a stride for each dimension.
 template <typename TLayout>
-concept MdspanLayout =
+concept MdspanLayoutStrided =
     (MdspanLayoutContinuous<TLayout> || MdspanLayoutStride<TLayout>);
 
+template <typename TLayout>
+concept MdspanLayoutTiled = is_layout_tiled_v<TLayout>;
+
+template <typename TLayout>
+concept MdspanLayout =
+    (MdspanLayoutStrided<TLayout> || MdspanLayoutTiled<TLayout>);
+
 /// @brief Return name of the layout as string.
 /// @tparam TLayout Layout type.
 /// @return Name.
@@ -60,6 +77,8 @@ template <MdspanLayout TLayout> constexpr char const *get_layout_name() {
     return "right\n";
   } else if (std::is_same_v<TLayout, std::experimental::layout_stride>) {
     return "stride\n";
+  } else if (MdspanLayoutTiled<TLayout>) {
+    return "tiled\n";
   } else {
     return "impossible\n";
   }
@@ -82,3 +101,59 @@ void print1D(std::ranges::random_access_range auto vec,
   }
   std::cout << std::endl;
 }
+
+/// @brief Print, if a check was successful.
+inline bool print_check(std::string_view const name, bool const check) {
+  std::cout << name << (check ? " was successful\n" : " failed\n");
+  return check;
+}
+
+/// @brief Measure the runtime of func and print it.
+/// @return Result of func, which is printed too, if func does not return void.
+template <typename TFunc>
+decltype(auto) measure(std::string_view const name, TFunc &&func) {
+  auto const start = std::chrono::steady_clock::now();
+  auto const print_time = [&]() {
+    std::cout << "   " << name << ": "
+              << std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - start)
+                     .count()
+              << " ms";
+  };
+  if constexpr (std::is_void_v<std::invoke_result_t<TFunc &>>) {
+    func();
+    print_time();
+    std::cout << "\n";
+  } else {
+    auto const result = func();
+    print_time();
+    std::cout << " (result " << result << ")\n";
+    return result;
+  }
+}
+
+/// @brief Compare each element of two mdspans with the same extents.
+/// @return True, if all elements are equal.
+template <typename TMdspanA, typename TMdspanB>
+bool is_equal(TMdspanA a, TMdspanB b) {
+  std::size_t constexpr rank = TMdspanA::rank();
+  std::array<std::size_t, rank> index{};
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    auto const get = [&index](auto m) {
+      return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return m[index[I]...];
+      }(std::make_index_sequence<rank>{});
+    };
+    if (get(a) != get(b)) {
+      return false;
+    }
+    // increment the index like layout_right
+    for (std::size_t d = rank; d > 0; --d) {
+      if (++index[d - 1] < a.extent(d - 1)) {
+        break;
+      }
+      index[d - 1] = 0;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,160 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/mdspan>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "allocators.hpp"
+#include "md_algorithm.hpp"
+#include "mdarray.hpp"
+#include "utils.hpp"
+
+namespace stdex = std::experimental;
+
+/// @brief Fill a mdarray via its view and check the result via operator[] of
+/// the mdarray.
+/// @return True, if the view and the mdarray access the same elements.
+template <typename TMdarray> bool check_view(TMdarray &array) {
+  auto m = array.view();
+  for (std::size_t y = 0; y < m.extent(0); ++y) {
+    for (std::size_t x = 0; x < m.extent(1); ++x) {
+      m[y, x] = static_cast<float>(y * m.extent(1) + x);
+    }
+  }
+  bool check = true;
+  for (std::size_t y = 0; y < array.extent(0); ++y) {
+    for (std::size_t x = 0; x < array.extent(1); ++x) {
+      check &= array[y, x] == static_cast<float>(y * array.extent(1) + x);
+    }
+  }
+  return check;
+}
+
+/// @brief Element, whose copy constructor throws after copies_left copies.
+struct ThrowingCopy {
+  static inline int copies_left = 0;
+
+  ThrowingCopy() = default;
+  ThrowingCopy(ThrowingCopy const &) {
+    if (copies_left-- == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+};
+
+/// @brief std::allocator, which counts the currently allocated elements.
+template <typename T> struct CountingAllocator : std::allocator<T> {
+  static inline std::ptrdiff_t allocated = 0;
+
+  template <typename U> struct rebind {
+    using other = CountingAllocator<U>;
+  };
+
+  T *allocate(std::size_t const n) {
+    allocated += n;
+    return std::allocator<T>::allocate(n);
+  }
+
+  void deallocate(T *ptr, std::size_t const n) {
+    allocated -= n;
+    std::allocator<T>::deallocate(ptr, n);
+  }
+};
+
+int main(int argc, char **argv) {
+  std::size_t constexpr y_size = 37;
+  std::size_t constexpr x_size = 53;
+  using Extents2D = stdex::dextents<std::size_t, 2>;
+  bool check = true;
+
+  std::cout << ">>> mdarray with different allocators\n";
+  mdarray<float, Extents2D> default_array(Extents2D{y_size, x_size});
+  check &= print_check("   std::allocator", check_view(default_array));
+
+  mdarray<float, Extents2D, stdex::layout_left, AlignedAllocator<float, 64>>
+      aligned_array(Extents2D{y_size, x_size});
+  check &= print_check(
+      "   AlignedAllocator",
+      check_view(aligned_array) &&
+          reinterpret_cast<std::uintptr_t>(aligned_array.data()) % 64 == 0);
+
+  Arena arena(1 << 20);
+  {
+    using ArenaArray = mdarray<float, Extents2D, stdex::layout_right,
+                               ArenaAllocator<float>>;
+    ArenaArray first(Extents2D{y_size, x_size}, ArenaAllocator<float>(arena));
+    ArenaArray second(Extents2D{y_size, x_size}, 1.f,
+                      ArenaAllocator<float>(arena));
+    check &= print_check(
+        "   ArenaAllocator",
+        check_view(first) && md_reduce(second.view()) == y_size * x_size &&
+            arena.used() >= 2 * y_size * x_size * sizeof(float));
+  }
+  arena.reset();
+
+#if defined(__linux__)
+  mdarray<float, Extents2D, stdex::layout_right, HugePageAllocator<float>>
+      huge_page_array(Extents2D{y_size, x_size});
+  check &= print_check(
+      "   HugePageAllocator",
+      check_view(huge_page_array) &&
+          reinterpret_cast<std::uintptr_t>(huge_page_array.data()) %
+                  HugePageAllocator<float>::huge_page_size ==
+              0);
+
+  mdarray<float, Extents2D, stdex::layout_right, NumaLocalAllocator<float>>
+      numa_array(Extents2D{y_size, x_size});
+  check &= print_check("   NumaLocalAllocator", check_view(numa_array));
+#endif
+
+  // padded layout_stride mapping
+  stdex::layout_stride::mapping<Extents2D> const padded_mapping{
+      Extents2D{y_size, x_size}, std::array<std::size_t, 2>{x_size + 3, 1}};
+  mdarray<float, Extents2D, stdex::layout_stride> padded_array(padded_mapping);
+  check &= print_check("   layout_stride with padding",
+                       check_view(padded_array) &&
+                           padded_array.mapping().required_span_size() ==
+                               (y_size - 1) * (x_size + 3) + x_size);
+
+  // copies are deep, moves transfer the memory
+  mdarray<float, Extents2D> copy = default_array;
+  copy[0, 0] = -1.f;
+  float const *const data = copy.data();
+  mdarray<float, Extents2D> moved = std::move(copy);
+  check &= print_check("   copy and move", default_array[0, 0] == 0.f &&
+                                            moved[0, 0] == -1.f &&
+                                            moved.data() == data);
+
+  // the memory is released, if the construction of an element throws
+  bool thrown = false;
+  ThrowingCopy::copies_left = 10;
+  try {
+    mdarray<ThrowingCopy, Extents2D, stdex::layout_right,
+            CountingAllocator<ThrowingCopy>> const
+        array(Extents2D{y_size, x_size}, ThrowingCopy{});
+  } catch (std::runtime_error const &) {
+    thrown = true;
+  }
+  check &= print_check("   exception in the constructor",
+                       thrown && CountingAllocator<ThrowingCopy>::allocated ==
+                                     0);
+  std::cout << "<<<\n\n";
+
+  std::cout << ">>> runtime of the allocation of 256 MiB\n";
+  std::size_t constexpr bench_size = std::size_t{8} << 10;
+  measure("std::vector (value-initialized)", [&]() {
+    std::vector<float> data(bench_size * bench_size);
+    check &= data[bench_size] == 0.f;
+  });
+  measure("mdarray (uninitialized)", [&]() {
+    mdarray<float, Extents2D> array(Extents2D{bench_size, bench_size});
+    check &= array.data() != nullptr;
+  });
+  std::cout << "<<<\n";
+
+  return check ? 0 : 1;
+}
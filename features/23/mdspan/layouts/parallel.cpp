@@ -0,0 +1,118 @@
+#include <cstddef>
+#include <execution>
+#include <experimental/mdspan>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "md_algorithm.hpp"
+#include "md_parallel.hpp"
+#include "utils.hpp"
+
+namespace stdex = std::experimental;
+
+int main(int argc, char **argv) {
+  // 3D tensor with padding at the end of each row
+  std::size_t constexpr z_size = 64;
+  std::size_t constexpr y_size = 256;
+  std::size_t constexpr x_size = 1000;
+  std::size_t constexpr x_padding = 24;
+  std::size_t constexpr x_pitch = x_size + x_padding;
+  using Extents3D = stdex::dextents<std::size_t, 3>;
+  bool check = true;
+
+  std::vector<float> data(z_size * y_size * x_pitch, -1.f);
+  stdex::mdspan m(data.data(), stdex::layout_stride::mapping<Extents3D>{
+                                   Extents3D{z_size, y_size, x_size},
+                                   std::array<std::size_t, 3>{
+                                       y_size * x_pitch, x_pitch, 1}});
+
+  std::cout << ">>> md_parallel_fill\n";
+  md_parallel_fill(m, 1.f);
+  check &= print_check("md_parallel_fill(padded tensor)",
+                       md_reduce(m) == static_cast<double>(m.size()));
+  bool padding_untouched = true;
+  for (std::size_t row = 0; row < z_size * y_size; ++row) {
+    for (std::size_t x = x_size; x < x_pitch; ++x) {
+      padding_untouched &= data[row * x_pitch + x] == -1.f;
+    }
+  }
+  check &= print_check("padding is untouched", padding_untouched);
+  md_parallel_fill(std::execution::par_unseq, m, 2.f);
+  check &= print_check("md_parallel_fill(par_unseq, padded tensor)",
+                       md_reduce(m) == 2. * m.size());
+
+  // A tensor with a short outermost dimension is split in enough blocks by
+  // collapsing the outer dimensions. Each element is part of exactly one block.
+  auto const covers_each_element_once = [](auto m_short) {
+    md_fill(m_short, 0.f);
+    detail::MdspanBlocks const blocks(m_short, default_number_of_blocks);
+    for (std::size_t b = 0; b < blocks.size(); ++b) {
+      blocks.for_each_part(b, [](auto const &part) {
+        md_transform(part, part, [](float const v) { return v + 1.f; });
+      });
+    }
+    return blocks.size() == default_number_of_blocks &&
+           md_reduce(m_short) == static_cast<double>(m_short.size()) &&
+           md_parallel_transform_reduce(
+               m_short, 0.f, [](float a, float b) { return std::max(a, b); },
+               [](float const v) { return v; }) == 1.f;
+  };
+  check &= print_check(
+      "blocks of a padded 2x3x1000 tensor",
+      covers_each_element_once(stdex::mdspan(
+          data.data(), stdex::layout_stride::mapping<Extents3D>{
+                           Extents3D{2, 3, x_size},
+                           std::array<std::size_t, 3>{y_size * x_pitch,
+                                                      x_pitch, 1}})));
+  check &= print_check(
+      "blocks of a 1000x3x2 layout_left tensor",
+      covers_each_element_once(
+          stdex::mdspan<float, Extents3D, stdex::layout_left>(
+              data.data(), Extents3D{x_size, 3, 2})));
+  std::cout << "<<<\n\n";
+
+  std::cout << ">>> md_parallel_transform_reduce\n";
+  // values with many different exponents, where the result of a floating
+  // point sum depends on the order of the additions
+  for (std::size_t z = 0; z < z_size; ++z) {
+    for (std::size_t y = 0; y < y_size; ++y) {
+      for (std::size_t x = 0; x < x_size; ++x) {
+        m[z, y, x] = 1.f / static_cast<float>(1 + (z * 7 + y * 3 + x) % 977);
+      }
+    }
+  }
+
+  auto const square = [](float const v) { return v * v; };
+  float const reference = md_parallel_transform_reduce(
+      m, 0.f, std::plus<>{}, square, std::size_t{1});
+  bool reproducible = true;
+  for (std::size_t threads : {2, 3, 4, 8, 16}) {
+    reproducible &= md_parallel_transform_reduce(m, 0.f, std::plus<>{}, square,
+                                                 threads) == reference;
+  }
+  reproducible &= md_parallel_transform_reduce(std::execution::par_unseq, m,
+                                               0.f, std::plus<>{},
+                                               square) == reference;
+  check &= print_check("md_parallel_transform_reduce is reproducible with "
+                       "different numbers of threads",
+                       reproducible);
+  std::cout << "<<<\n\n";
+
+  std::cout << ">>> runtime of the sum of a padded tensor\n";
+  md_fill(m, 1.f);
+  double const serial_sum =
+      measure("md_reduce", [&]() { return md_reduce(m); });
+  for (std::size_t threads = 1; threads <= 64; threads *= 2) {
+    std::string const name =
+        "md_parallel_reduce " + std::to_string(threads) + " threads";
+    check &= measure(name, [&]() {
+               return md_parallel_reduce(m, threads);
+             }) == serial_sum;
+  }
+  std::cout << "<<<\n";
+
+  return check ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+#include <array>
+#include <cstddef>
+#include <experimental/mdspan>
+#include <iostream>
+#include <numeric>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "md_relayout.hpp"
+#include "utils.hpp"
+
+namespace stdex = std::experimental;
+
+/// @brief Copy a layout_right mdspan with md_relayout() to layout_left and
+/// back and compare the result with the original.
+template <std::size_t Rank>
+bool check_relayout(std::array<std::size_t, Rank> const &extents) {
+  using Extents = stdex::dextents<std::size_t, Rank>;
+  std::size_t size = 1;
+  for (std::size_t const e : extents) {
+    size *= e;
+  }
+
+  std::vector<int> data_right(size);
+  std::vector<int> data_left(size);
+  std::vector<int> data_back(size);
+  std::iota(data_right.begin(), data_right.end(), 0);
+
+  stdex::mdspan m_right(data_right.data(), Extents{extents});
+  stdex::mdspan<int, Extents, stdex::layout_left> m_left(data_left.data(),
+                                                         Extents{extents});
+  stdex::mdspan m_back(data_back.data(), Extents{extents});
+
+  md_relayout(m_right, m_left);
+  bool check = is_equal(m_right, m_left);
+  md_relayout(m_left, m_back);
+  check &= data_back == data_right;
+  std::cout << "   rank " << Rank << ": ";
+  return print_check("md_relayout(right -> left -> right)", check);
+}
+
+int main(int argc, char **argv) {
+  bool check = true;
+  using Extents2D = stdex::dextents<std::size_t, 2>;
+
+  std::cout << ">>> md_relayout\n";
+  check &= check_relayout(std::array<std::size_t, 2>{37, 71});
+  check &= check_relayout(std::array<std::size_t, 3>{5, 67, 41});
+  check &= check_relayout(std::array<std::size_t, 4>{3, 4, 33, 35});
+
+  // padded layout_stride to layout_left
+  std::size_t constexpr y_size = 45;
+  std::size_t constexpr x_size = 50;
+  std::size_t constexpr x_padding = 6;
+  std::vector<int> data_padding(y_size * (x_size + x_padding), -1);
+  std::vector<int> data_left(y_size * x_size);
+  stdex::mdspan m_padding(data_padding.data(),
+                          stdex::layout_stride::mapping<Extents2D>{
+                              Extents2D{y_size, x_size},
+                              std::array<std::size_t, 2>{x_size + x_padding,
+                                                         1}});
+  stdex::mdspan<int, Extents2D, stdex::layout_left> m_left(
+      data_left.data(), Extents2D{y_size, x_size});
+  std::iota(data_left.begin(), data_left.end(), 0);
+  md_relayout(m_left, m_padding);
+  check &= print_check("   md_relayout(left -> padded stride)",
+                       is_equal(m_left, m_padding) &&
+                           data_padding[x_size] == -1);
+  std::cout << "<<<\n\n";
+
+  std::cout << ">>> md_transpose_inplace\n";
+  std::size_t constexpr n = 100;
+  std::vector<int> data_square(n * (n + x_padding), -1);
+  std::vector<int> data_expected(n * n);
+  stdex::mdspan m_square(data_square.data(),
+                         stdex::layout_stride::mapping<Extents2D>{
+                             Extents2D{n, n},
+                             std::array<std::size_t, 2>{n + x_padding, 1}});
+  stdex::mdspan m_expected(data_expected.data(), Extents2D{n, n});
+  for (std::size_t y = 0; y < n; ++y) {
+    for (std::size_t x = 0; x < n; ++x) {
+      m_square[y, x] = static_cast<int>(y * n + x);
+      m_expected[x, y] = static_cast<int>(y * n + x);
+    }
+  }
+  md_transpose_inplace(m_square);
+  check &= print_check("   md_transpose_inplace(padded matrix)",
+                       is_equal(m_square, m_expected) &&
+                           data_square[n] == -1);
+  std::cout << "<<<\n\n";
+
+  std::cout << ">>> runtime of layout_right -> layout_left\n";
+  std::size_t constexpr bench_size = 4096;
+  std::vector<float> bench_right(bench_size * bench_size, 1.f);
+  std::vector<float> bench_left(bench_size * bench_size);
+  stdex::mdspan m_bench_right(bench_right.data(),
+                              Extents2D{bench_size, bench_size});
+  stdex::mdspan<float, Extents2D, stdex::layout_left> m_bench_left(
+      bench_left.data(), Extents2D{bench_size, bench_size});
+
+  measure("nested loops", [&]() {
+    for (std::size_t y = 0; y < bench_size; ++y) {
+      for (std::size_t x = 0; x < bench_size; ++x) {
+        m_bench_left[y, x] = m_bench_right[y, x];
+      }
+    }
+  });
+  measure("md_relayout", [&]() { md_relayout(m_bench_right, m_bench_left); });
+  check &= print_check("   md_relayout", is_equal(m_bench_right, m_bench_left));
+  std::cout << "<<<\n";
+
+  return check ? 0 : 1;
+}
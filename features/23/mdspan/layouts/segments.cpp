@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <experimental/mdspan>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+#include "segment.hpp"
+#include "utils.hpp"
+
+namespace stdex = std::experimental;
+
+/// @brief Print each contiguous run of the mdspan as offset in the memory and
+/// length. Afterwards, fill all runs with memset and check, that exactly the
+/// elements of the mdspan are set.
+/// @param name Name of the mdspan.
+/// @param m mdspan, which points into data.
+/// @param data Memory of the mdspan.
+/// @return True, if the runs cover each element of the mdspan exactly once.
+template <typename TMdspan>
+bool print_segments(std::string_view const name, TMdspan m,
+                    std::vector<int> &data) {
+  std::cout << ">>> segments of " << name << " with layout "
+            << get_layout_name<typename TMdspan::layout_type>();
+
+  std::fill(data.begin(), data.end(), 0);
+  std::size_t number_of_elements = 0;
+  for_each_segment(m, [&](int *run, std::size_t const length) {
+    std::cout << "   offset " << run - data.data() << ", length " << length
+              << "\n";
+    // each element is a int with all bytes 0x01
+    std::memset(run, 1, length * sizeof(int));
+    number_of_elements += length;
+  });
+
+  int constexpr marker = 0x01010101;
+  bool check = number_of_elements == m.size();
+  std::size_t marked_elements = 0;
+  for (int const v : data) {
+    marked_elements += (v == marker) ? 1 : 0;
+  }
+  check &= marked_elements == m.size();
+
+  // each element of the mdspan needs to be marked
+  std::vector<int> values;
+  for (std::size_t y = 0; y < m.extent(0); ++y) {
+    for (std::size_t x = 0; x < m.extent(1); ++x) {
+      values.push_back(m[y, x]);
+    }
+  }
+  check &= std::all_of(values.begin(), values.end(),
+                       [](int const v) { return v == marker; });
+
+  std::cout << "   " << (check ? "all" : "not all") << " " << m.size()
+            << " elements are covered\n";
+  std::cout << "<<<\n";
+  return check;
+}
+
+int main(int argc, char **argv) {
+  std::size_t constexpr y_size = 4;
+  std::size_t constexpr x_size = 6;
+  std::size_t constexpr x_padding = 2;
+
+  std::vector<int> data(y_size * (x_size + x_padding));
+  using Extents2D = stdex::dextents<std::size_t, 2>;
+  bool check = true;
+
+  // no padding: a single run
+  check &= print_segments(
+      "matrix", stdex::mdspan(data.data(), Extents2D{y_size, x_size}), data);
+  std::cout << "\n";
+
+  check &= print_segments(
+      "matrix",
+      stdex::mdspan<int, Extents2D, stdex::layout_left>(
+          data.data(), Extents2D{y_size, x_size}),
+      data);
+  std::cout << "\n";
+
+  // layout_stride without padding: both dimensions are merged to a single run
+  check &= print_segments(
+      "matrix",
+      stdex::mdspan(data.data(), stdex::layout_stride::mapping<Extents2D>{
+                                     Extents2D{y_size, x_size},
+                                     std::array<std::size_t, 2>{x_size, 1}}),
+      data);
+  std::cout << "\n";
+
+  // padding at the end of each row: one run per row
+  check &= print_segments(
+      "padded matrix",
+      stdex::mdspan(data.data(), stdex::layout_stride::mapping<Extents2D>{
+                                     Extents2D{y_size, x_size},
+                                     std::array<std::size_t, 2>{
+                                         x_size + x_padding, 1}}),
+      data);
+  std::cout << "\n";
+
+  // every second column: each element is a run
+  check &= print_segments(
+      "every second column",
+      stdex::mdspan(data.data(), stdex::layout_stride::mapping<Extents2D>{
+                                     Extents2D{y_size, x_size / 2},
+                                     std::array<std::size_t, 2>{x_size, 2}}),
+      data);
+  std::cout << "\n";
+
+  // transposed view of the padded matrix: the runs are the rows in memory
+  check &= print_segments(
+      "transposed padded matrix",
+      stdex::mdspan(data.data(), stdex::layout_stride::mapping<Extents2D>{
+                                     Extents2D{x_size, y_size},
+                                     std::array<std::size_t, 2>{
+                                         1, x_size + x_padding}}),
+      data);
+  std::cout << "\n";
+
+  if (check) {
+    std::cout << "for_each_segment() covers each element exactly once\n";
+  } else {
+    std::cout << "for_each_segment() does not cover each element exactly "
+                 "once\n";
+  }
+
+  return check ? 0 : 1;
+}
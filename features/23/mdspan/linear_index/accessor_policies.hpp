@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <experimental/mdspan>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// ###########################################################################
+// accessor policies
+// ###########################################################################
+// Each accessor policy can replace the std::experimental::default_accessor of
+// a mdspan. The algorithms access the elements only via the accessor,
+// therefore the policy can be swapped without changing the algorithm.
+
+// ###########################################################################
+// non-temporal streaming stores
+// ###########################################################################
+
+/// @brief Store value at ptr with a non-temporal store, which bypasses the
+/// cache hierarchy. Falls back to a normal store, if the element type or the
+/// architecture does not support non-temporal stores.
+template <typename TElement>
+void stream_store(TElement *ptr, TElement const &value) {
+#if defined(__SSE2__)
+  if constexpr (std::is_trivially_copyable_v<TElement> &&
+                sizeof(TElement) == sizeof(int)) {
+    int bits;
+    std::memcpy(&bits, &value, sizeof(int));
+    _mm_stream_si32(reinterpret_cast<int *>(ptr), bits);
+    return;
+  }
+#if defined(__x86_64__)
+  if constexpr (std::is_trivially_copyable_v<TElement> &&
+                sizeof(TElement) == sizeof(long long)) {
+    long long bits;
+    std::memcpy(&bits, &value, sizeof(long long));
+    _mm_stream_si64(reinterpret_cast<long long *>(ptr), bits);
+    return;
+  }
+#endif
+#endif
+  *ptr = value;
+}
+
+/// @brief Reference of the streaming_accessor. Assigning a value issues a
+/// non-temporal store, reading a value is a normal load.
+template <typename TElement> class StreamingReference {
+  TElement *m_ptr;
+
+public:
+  explicit StreamingReference(TElement *ptr) : m_ptr(ptr) {}
+
+  StreamingReference &operator=(TElement const &value) {
+    stream_store(m_ptr, value);
+    return *this;
+  }
+
+  operator TElement() const { return *m_ptr; }
+};
+
+/// @brief Accessor for write-once output. The stores do not allocate cache
+/// lines, therefore they do not evict the input data of the algorithm from
+/// the last level cache. Non-temporal stores are weakly ordered: flush()
+/// needs to be called before another thread reads the data.
+///
+/// Each element is written with a scalar movnti, because the accessor only
+/// sees a single element. The compiler cannot vectorize the proxy stores,
+/// therefore filling a 64 MiB buffer is slower than with the default_accessor
+/// (median 14.9 ms vs. 10.3 ms in main.cpp). The accessor only pays off, if the
+/// algorithm is limited by cache pollution instead of store bandwidth.
+/// @tparam TElement element type of the mdspan
+template <typename TElement> struct streaming_accessor {
+  using offset_policy = streaming_accessor;
+  using element_type = TElement;
+  using reference = StreamingReference<TElement>;
+  using data_handle_type = TElement *;
+
+  constexpr streaming_accessor() noexcept = default;
+  constexpr streaming_accessor(
+      std::experimental::default_accessor<TElement>) noexcept {}
+
+  reference access(data_handle_type p, std::size_t i) const noexcept {
+    return reference(p + i);
+  }
+
+  data_handle_type offset(data_handle_type p, std::size_t i) const noexcept {
+    return p + i;
+  }
+
+  /// @brief Make all non-temporal stores visible to other threads.
+  static void flush() noexcept {
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+  }
+};
+
+// ###########################################################################
+// assume aligned
+// ###########################################################################
+
+/// @brief Accessor, which promises the compiler, that the data handle is
+/// aligned to TAlignment bytes. This allows aligned vector loads and stores
+/// without a runtime check or peeling loop. The alignment needs to be
+/// guaranteed by the allocation, otherwise the behavior is undefined. The
+/// accessor does not make any promise about aliasing.
+/// @tparam TElement element type of the mdspan
+/// @tparam TAlignment alignment of the data handle in bytes
+template <typename TElement, std::size_t TAlignment = 64>
+struct aligned_accessor {
+  static_assert((TAlignment & (TAlignment - 1)) == 0,
+                "TAlignment needs to be a power of 2");
+
+  using offset_policy = std::experimental::default_accessor<TElement>;
+  using element_type = TElement;
+  using reference = TElement &;
+  using data_handle_type = TElement *;
+
+  static std::size_t constexpr alignment = TAlignment;
+
+  constexpr aligned_accessor() noexcept = default;
+  constexpr aligned_accessor(
+      std::experimental::default_accessor<TElement>) noexcept {}
+
+  reference access(data_handle_type p, std::size_t i) const noexcept {
+#if defined(__GNUC__)
+    return static_cast<TElement *>(__builtin_assume_aligned(p, TAlignment))[i];
+#else
+    return p[i];
+#endif
+  }
+
+  // an offset pointer is not aligned anymore
+  typename offset_policy::data_handle_type
+  offset(data_handle_type p, std::size_t i) const noexcept {
+    return p + i;
+  }
+
+  // submdspan constructs the offset_policy from the accessor
+  constexpr operator std::experimental::default_accessor<TElement>()
+      const noexcept {
+    return {};
+  }
+};
+
+static_assert(
+    std::is_constructible_v<aligned_accessor<int>::offset_policy,
+                            aligned_accessor<int>>,
+    "the offset_policy needs to be constructible from the accessor");
+
+// ###########################################################################
+// helper
+// ###########################################################################
+
+template <typename TAccessor, typename = void>
+struct has_flush : std::false_type {};
+
+template <typename TAccessor>
+struct has_flush<TAccessor, std::void_t<decltype(TAccessor::flush())>>
+    : std::true_type {};
+
+/// @brief Call flush() of the accessor, if the accessor has weakly ordered
+/// stores. Needs to be called at the end of an algorithm, which writes data.
+template <typename TAccessor> void flush_accessor(TAccessor const &) {
+  if constexpr (has_flush<TAccessor>::value) {
+    TAccessor::flush();
+  }
+}
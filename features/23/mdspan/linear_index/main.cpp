@@ -1,9 +1,17 @@
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstdlib>
 #include <experimental/mdspan>
 #include <iostream>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "accessor_policies.hpp"
+
 // ###########################################################################
 // adapter
 // ###########################################################################
@@ -36,14 +44,20 @@ private:
   using element_type = typename mdspan_type::element_type;
   // index type
   using index_type = typename mdspan_type::index_type;
+  // reference type of the accessor, can be a proxy object
+  using reference = typename mdspan_type::reference;
 
   mdspan_type m_mdspan;
+  // step size of each rank, calculated once in the constructor (see class
+  // documentation). Only used for ranks, where the step size depends on a
+  // dynamic extent.
+  std::array<index_type, mdspan_type::rank()> m_step_size{};
 
   /// @brief Depending of the type of the extend (static or dynamic) call the
   /// correct extends function and return the value.
   /// @tparam current_rank Rank where to get the size.
   /// @return Size of the rank.
-  template <index_type current_rank> index_type get_extent_helper() {
+  template <index_type current_rank> index_type get_extent_helper() const {
     if constexpr (mdspan_type::static_extent(current_rank) ==
                   std::experimental::dynamic_extent)
       return m_mdspan.extent(current_rank);
@@ -52,26 +66,47 @@ private:
     }
   }
 
-  /// @brief Calculate the step size for the rank (see class documentation).
+  /// @brief Check, if all extents, which are required to calculate the step
+  /// size of a rank, are static.
+  /// @tparam final_rank Rank of the step size.
+  /// @return True, if the step size is a compile time constant.
+  template <index_type final_rank> static constexpr bool is_static_step_size() {
+    for (std::size_t r = final_rank + 1; r < mdspan_type::rank(); ++r) {
+      if (mdspan_type::static_extent(r) == std::experimental::dynamic_extent) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief Calculate the step size of a rank from static extents.
+  /// @tparam final_rank Rank of the step size.
+  /// @return Product of the static extents of all ranks after final_rank.
+  template <index_type final_rank>
+  static constexpr index_type calculate_static_step_size() {
+    index_type step_size = 1;
+    for (std::size_t r = final_rank + 1; r < mdspan_type::rank(); ++r) {
+      step_size *= static_cast<index_type>(mdspan_type::static_extent(r));
+    }
+    return step_size;
+  }
+
+  /// @brief Return the step size for the rank (see class documentation). If
+  /// the step size depends only on static extents, it is a compile time
+  /// constant, otherwise it is loaded from the step sizes, which are
+  /// calculated in the constructor.
   /// @tparam final_rank The searched rank.
-  /// @tparam current_rank Iterator variable for the algorithm. Should be not
-  /// set by the user.
   /// @return Step size for rank `final_rank`.
-  template <index_type final_rank,
-            index_type current_rank = mdspan_type::rank() - 1>
-  index_type calculate_step_size() {
-    if constexpr (final_rank == mdspan_type::rank() - 1) {
-      return 1;
-    } else if constexpr (current_rank > final_rank) {
-      return get_extent_helper<current_rank>() *
-             calculate_step_size<final_rank, current_rank - 1>();
+  template <index_type final_rank> index_type calculate_step_size() const {
+    if constexpr (is_static_step_size<final_rank>()) {
+      return calculate_static_step_size<final_rank>();
     } else {
-      return 1;
+      return m_step_size[final_rank];
     }
   }
 
   template <index_type current_rank, index_type final_rank>
-  index_type calculate_extend_index_impl(index_type const index) {
+  index_type calculate_extend_index_impl(index_type const index) const {
     index_type const stepSize = calculate_step_size<current_rank>();
     index_type extend_index = index / stepSize;
 
@@ -85,7 +120,7 @@ private:
 
   template <index_type current_rank, typename TTupel>
   auto calculate_extend_index_impl_v2(index_type const index,
-                                      TTupel const multi_index_before) {
+                                      TTupel const multi_index_before) const {
     index_type const stepSize = calculate_step_size<current_rank>();
     index_type current_multi_index = index / stepSize;
     auto const multi_index =
@@ -102,7 +137,7 @@ private:
   /// @brief Creates of tuple of index positions for each extend.
   /// @param index Linear index, which is mapped to the multi dimensional index.
   /// @return Tupel with index positions.
-  auto calculate_extend_index_impl_v2(index_type const index) {
+  auto calculate_extend_index_impl_v2(index_type const index) const {
     index_type const stepSize = calculate_step_size<0>();
     auto const current_multi_index = index / stepSize;
     std::tuple<index_type> multi_index = {current_multi_index};
@@ -121,13 +156,13 @@ private:
   /// @return Returns the dimension index of the rank `final_rank` calculated
   /// from the linear `index`.
   template <index_type final_rank>
-  index_type calculate_extend_index(index_type const index) {
+  index_type calculate_extend_index(index_type const index) const {
     return calculate_extend_index_impl<0, final_rank>(index);
   }
 
   template <index_type... I>
-  auto &access_linear_index_impl(index_type const index,
-                                 std::index_sequence<I...>) {
+  reference access_linear_index_impl(index_type const index,
+                                     std::index_sequence<I...>) const {
 #if MDSPAN_USE_BRACKET_OPERATOR
     return m_mdspan[calculate_extend_index<I>(index)...];
 #else
@@ -135,30 +170,77 @@ private:
 #endif
   }
 
-  auto &access_linear_index_impl_v2(index_type const index) {
+  reference access_linear_index_impl_v2(index_type const index) const {
 #if MDSPAN_USE_BRACKET_OPERATOR
     return std::apply(
-        [this](auto &&...indices) -> element_type & {
+        [this](auto &&...indices) -> reference {
           return m_mdspan[indices...];
         },
         calculate_extend_index_impl_v2(index));
 
 #else
     return std::apply(
-        [this](auto &&...indices) -> element_type & {
+        [this](auto &&...indices) -> reference {
           return m_mdspan(indices...);
         },
         calculate_extend_index_impl_v2(index));
 #endif
   }
 
+  /// @brief Iterate with nested loops over all elements. Only the offset of
+  /// the outer dimensions is calculated and the innermost dimension is a run,
+  /// where the offset is bumped by the stride (1 for contiguous rows).
+  /// @tparam current_rank Rank of the current loop.
+  /// @param offset Offset of the first element of the current loop.
+  /// @param func Function, which is called with each element.
+  template <index_type current_rank, typename TFunc>
+  void for_each_element_impl(index_type const offset, TFunc &func) const {
+    index_type const extent = get_extent_helper<current_rank>();
+    index_type const stride = m_mdspan.stride(current_rank);
+
+    if constexpr (current_rank == mdspan_type::rank() - 1) {
+      auto const data = m_mdspan.data_handle();
+      auto const &accessor = m_mdspan.accessor();
+      for (index_type i = 0; i < extent; ++i) {
+        func(accessor.access(data, offset + i * stride));
+      }
+    } else {
+      for (index_type i = 0; i < extent; ++i) {
+        for_each_element_impl<current_rank + 1>(offset + i * stride, func);
+      }
+    }
+  }
+
 public:
-  MdSpanLinearAdapter(mdspan_type mdspan) : m_mdspan(mdspan) {}
+  MdSpanLinearAdapter(mdspan_type mdspan) : m_mdspan(mdspan) {
+    if constexpr (mdspan_type::rank() > 0) {
+      m_step_size[mdspan_type::rank() - 1] = 1;
+      for (std::size_t r = mdspan_type::rank() - 1; r > 0; --r) {
+        m_step_size[r - 1] = m_step_size[r] * m_mdspan.extent(r);
+      }
+    }
+  }
+
+  /// @brief Call func for each element in the order of the linear index.
+  /// Requires a strided layout, e.g. layout_stride with padding. In contrast
+  /// to operator[], no multi dimensional index is calculated per element.
+  /// Instead, the elements are traversed segment-wise: the innermost dimension
+  /// is a run with a constant stride and the outer dimensions jump by their
+  /// strides. Therefore, the padding elements are skipped without any division.
+  /// @param func Function, which is called with a reference to each element.
+  /// The reference is the reference type of the accessor.
+  template <typename TFunc> void for_each_element(TFunc &&func) const {
+    static_assert(mdspan_type::is_always_strided(),
+                  "for_each_element() requires a strided layout");
+    if constexpr (mdspan_type::rank() > 0) {
+      for_each_element_impl<0>(0, func);
+    }
+  }
 
   /// @brief Access element of mdspan with linear index.
   /// @param index Linear index.
   /// @return element at postion index
-  element_type &operator[](index_type const index) const {
+  reference operator[](index_type const index) const {
     static_assert((IndexCalculationVersion > 0 && IndexCalculationVersion < 3),
                   "Unknown IndexCalculationVersion");
 
@@ -170,7 +252,7 @@ public:
     }
   }
 
-  element_type &operator[](index_type const index) {
+  reference operator[](index_type const index) {
     static_assert((IndexCalculationVersion > 0 && IndexCalculationVersion < 3),
                   "Unknown IndexCalculationVersion");
 
@@ -192,25 +274,27 @@ public:
 // ###########################################################################
 
 /// @brief Because the code is C++ 17, std::span is not available. Implement own
-/// version of std::span, which provide all required elements.
+/// version of std::span, which provide all required elements. The elements are
+/// accessed via the accessor of the mdspan.
+/// @tparam TElement element type of the mdspan
 /// @tparam TExtents extend of the mdspan
 /// @tparam TLayoutPolicy mapping of the mdspan
 /// @tparam TAccessorPolicy accessor of the mdspan
-template <typename TExtents, typename TLayoutPolicy, typename TAccessorPolicy>
+template <typename TElement, typename TExtents, typename TLayoutPolicy,
+          typename TAccessorPolicy>
 class SimpleSpan {
-  using mdspan_type =
-      std::experimental::mdspan<TExtents, TLayoutPolicy, TAccessorPolicy>;
+  using mdspan_type = std::experimental::mdspan<TElement, TExtents,
+                                                TLayoutPolicy, TAccessorPolicy>;
   using element_type = typename mdspan_type::element_type;
   using index_type = typename mdspan_type::index_type;
+  using reference = typename mdspan_type::reference;
   mdspan_type m_mdspan;
 
 public:
-  SimpleSpan(
-      std::experimental::mdspan<TExtents, TLayoutPolicy, TAccessorPolicy> m)
-      : m_mdspan(m) {}
+  SimpleSpan(mdspan_type m) : m_mdspan(m) {}
 
-  element_type &operator[](index_type const index) {
-    return m_mdspan.data_handle()[index];
+  reference operator[](index_type const index) {
+    return m_mdspan.accessor().access(m_mdspan.data_handle(), index);
   }
 
   auto size() const { return m_mdspan.size(); }
@@ -227,23 +311,33 @@ template <typename TSpan> void iterate_over_all_elements_impl(TSpan span) {
 }
 
 /// @brief Iterate over all elements and set it to 1.
+/// @tparam TElement element type of the mdspan
 /// @tparam TExtents extend of the mdspan
 /// @tparam TLayoutPolicy mapping of the mdspan
-/// @tparam TAccessorPolicy accessor of the mdspan
+/// @tparam TAccessorPolicy accessor of the mdspan, e.g. streaming_accessor
 /// @param m mdspan with data
-template <typename TExtents, typename TLayoutPolicy, typename TAccessorPolicy>
+template <typename TElement, typename TExtents, typename TLayoutPolicy,
+          typename TAccessorPolicy>
 void iterate_over_all_elements(
-    std::experimental::mdspan<TExtents, TLayoutPolicy, TAccessorPolicy> m) {
+    std::experimental::mdspan<TElement, TExtents, TLayoutPolicy,
+                              TAccessorPolicy>
+        m) {
   if constexpr (m.is_always_exhaustive()) {
     std::cout
         << "use optimized way to iterate over all elements (no padding used)\n";
     iterate_over_all_elements_impl(SimpleSpan{m});
 
+  } else if constexpr (m.is_always_strided()) {
+    std::cout << "use segment-wise way to iterate over all elements (padding "
+                 "used)\n";
+    MdSpanLinearAdapter{m}.for_each_element(
+        [](auto &&element) { element = 1; });
   } else {
     std::cout
         << "use adapter way to iterate over all elements (padding used)\n";
     iterate_over_all_elements_impl(MdSpanLinearAdapter{m});
   }
+  flush_accessor(m.accessor());
 }
 
 template <typename TSpan> int reduce_elements_impl(TSpan span) {
@@ -254,18 +348,45 @@ template <typename TSpan> int reduce_elements_impl(TSpan span) {
   return sum;
 }
 
+/// @brief Summarized all elements of a strided mdspan with the segment-wise
+/// traversal of MdSpanLinearAdapter.
+/// @tparam TElement element type of the mdspan
+/// @tparam TExtents extend of the mdspan
+/// @tparam TLayoutPolicy mapping of the mdspan
+/// @tparam TAccessorPolicy accessor of the mdspan, e.g. streaming_accessor
+/// @param m mdspan with data
+template <typename TElement, typename TExtents, typename TLayoutPolicy,
+          typename TAccessorPolicy>
+int reduce_elements_segment_wise(
+    std::experimental::mdspan<TElement, TExtents, TLayoutPolicy,
+                              TAccessorPolicy>
+        m) {
+  int sum = 0;
+  MdSpanLinearAdapter{m}.for_each_element(
+      [&sum](auto const &element) { sum += element; });
+  return sum;
+}
+
 /// @brief Summarized all elements of mdspan.
+/// @tparam TElement element type of the mdspan
 /// @tparam TExtents extend of the mdspan
 /// @tparam TLayoutPolicy mapping of the mdspan
-/// @tparam TAccessorPolicy accessor of the mdspan
+/// @tparam TAccessorPolicy accessor of the mdspan, e.g. streaming_accessor
 /// @param m mdspan with data
-template <typename TExtents, typename TLayoutPolicy, typename TAccessorPolicy>
+template <typename TElement, typename TExtents, typename TLayoutPolicy,
+          typename TAccessorPolicy>
 int reduce_elements(
-    std::experimental::mdspan<TExtents, TLayoutPolicy, TAccessorPolicy> m) {
+    std::experimental::mdspan<TElement, TExtents, TLayoutPolicy,
+                              TAccessorPolicy>
+        m) {
   if constexpr (m.is_always_exhaustive()) {
     std::cout
         << "use optimized way to iterate over all elements (no padding used)\n";
     return reduce_elements_impl(SimpleSpan{m});
+  } else if constexpr (m.is_always_strided()) {
+    std::cout << "use segment-wise way to iterate over all elements (padding "
+                 "used)\n";
+    return reduce_elements_segment_wise(m);
   } else {
     std::cout
         << "use adapter way to iterate over all elements (padding used)\n";
@@ -273,6 +394,39 @@ int reduce_elements(
   }
 }
 
+// ###########################################################################
+// checks
+// ###########################################################################
+
+/// @brief Compare each element accessed by the adapter (v1 and v2) with the
+/// memory of a mdspan with layout right, where the linear index is the memory
+/// offset.
+/// @tparam TMdspan mdspan with layout right
+/// @param m mdspan with data
+/// @return true, if all elements are equal
+template <typename TMdspan> bool check_adapter_index(TMdspan m) {
+  MdSpanLinearAdapter<typename TMdspan::element_type,
+                      typename TMdspan::extents_type,
+                      typename TMdspan::layout_type,
+                      typename TMdspan::accessor_type, 1>
+      adapter_v1(m);
+  MdSpanLinearAdapter<typename TMdspan::element_type,
+                      typename TMdspan::extents_type,
+                      typename TMdspan::layout_type,
+                      typename TMdspan::accessor_type, 2> const adapter_v2(m);
+
+  bool check = true;
+  for (std::size_t i = 0; i < m.size(); ++i) {
+    if (m.data_handle()[i] != adapter_v1[i] ||
+        m.data_handle()[i] != adapter_v2[i]) {
+      check = false;
+      std::cout << m.data_handle()[i] << " != " << adapter_v1[i] << " or "
+                << adapter_v2[i] << "\n";
+    }
+  }
+  return check;
+}
+
 // ###########################################################################
 // main
 // ###########################################################################
@@ -343,6 +497,34 @@ int main(int argc, char **argv) {
            "equal\n";
   }
 
+  std::cout << "\n";
+  std::cout << "###########################################################\n"
+            << "check index calculation with static and dynamic extents\n"
+            << "###########################################################\n";
+  // The step sizes of static extents are compile time constants and the step
+  // sizes of dynamic extents are calculated once by the adapter.
+  std::cout << "\n";
+
+  namespace stdex = std::experimental;
+
+  bool index_check_mixed = true;
+  index_check_mixed &= check_adapter_index(stdex::mdspan(
+      data.data(), stdex::extents{size_4d, size_3d, size_2d, size_1d}));
+  index_check_mixed &= check_adapter_index(stdex::mdspan(
+      data.data(),
+      stdex::extents<std::size_t, size_4d, stdex::dynamic_extent, size_2d,
+                     size_1d>{size_3d}));
+  index_check_mixed &= check_adapter_index(stdex::mdspan(
+      data.data(),
+      stdex::extents<std::size_t, stdex::dynamic_extent, size_3d,
+                     stdex::dynamic_extent, size_1d>{size_4d, size_2d}));
+  index_check_mixed &= check_adapter_index(stdex::mdspan(
+      data.data(), stdex::extents<std::size_t, size_4d, size_3d, size_2d,
+                                  stdex::dynamic_extent>{size_1d}));
+  if (index_check_mixed) {
+    std::cout << "indices matches for fully dynamic and mixed extents\n";
+  }
+
   std::cout << "\n";
   std::cout << "###########################################################\n"
             << "set all elements of 2D matrix (without padding) to 1 \n"
@@ -467,6 +649,134 @@ int main(int argc, char **argv) {
     std::cout << "reduce_elements(md_data4D) was successful\n";
   }
 
+  std::cout << "\n";
+  std::cout << "###########################################################\n"
+            << "runtime of reduce with and without padding \n"
+            << "###########################################################\n";
+  // The segment-wise traversal of the padded matrix should be as fast as the
+  // optimized way of the matrix without padding. The linear index adapter
+  // needs to calculate the multi dimensional index of each element.
+  std::cout << "\n";
+
+  std::size_t constexpr bench_rows = 2048;
+  std::size_t constexpr bench_columns = 2048;
+  std::size_t constexpr bench_padding = 16;
+  using Extend_bench = std::experimental::dextents<std::size_t, 2>;
+
+  std::vector<int> bench_data(bench_rows * bench_columns, 1);
+  std::experimental::mdspan md_bench(bench_data.data(),
+                                     Extend_bench{bench_rows, bench_columns});
+
+  std::vector<int> bench_data_padding(
+      bench_rows * (bench_columns + bench_padding), 1);
+  std::experimental::layout_stride::mapping<Extend_bench> bench_mp{
+      Extend_bench{bench_rows, bench_columns},
+      std::array<std::size_t, 2>{bench_columns + bench_padding, 1}};
+  std::experimental::mdspan md_bench_padding(bench_data_padding.data(),
+                                             bench_mp);
+
+  auto const measure = [](char const *name, auto &&func) {
+    auto const start = std::chrono::steady_clock::now();
+    int const sum = func();
+    auto const time = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    std::cout << name << ": " << time << " ms (sum " << sum << ")\n";
+    return sum;
+  };
+
+  int const expected_bench_sum = bench_rows * bench_columns;
+  bool bench_check = true;
+  bench_check &= measure("without padding, optimized way", [&]() {
+                   return reduce_elements_impl(SimpleSpan{md_bench});
+                 }) == expected_bench_sum;
+  bench_check &= measure("with padding, adapter way", [&]() {
+                   return reduce_elements_impl(
+                       MdSpanLinearAdapter{md_bench_padding});
+                 }) == expected_bench_sum;
+  bench_check &= measure("with padding, segment-wise way", [&]() {
+                   return reduce_elements_segment_wise(md_bench_padding);
+                 }) == expected_bench_sum;
+
+  if (bench_check) {
+    std::cout << "all reduce versions have the same result\n";
+  } else {
+    std::cout << "the reduce versions have different results\n";
+  }
+
+  std::cout << "\n";
+  std::cout << "###########################################################\n"
+            << "fill and reduce with different accessor policies \n"
+            << "###########################################################\n";
+  // The algorithms are not changed, only the accessor policy of the mdspan.
+  // The streaming accessor writes without allocating cache lines and the
+  // aligned accessor allows aligned vector instructions.
+  std::cout << "\n";
+
+  std::size_t constexpr policy_rows = 4096;
+  std::size_t constexpr policy_columns = 4096;
+  std::size_t constexpr policy_alignment = 64;
+  // aligned_alloc requires a size, which is a multiple of the alignment
+  int *policy_data = static_cast<int *>(std::aligned_alloc(
+      policy_alignment, policy_rows * policy_columns * sizeof(int)));
+  if (policy_data == nullptr) {
+    std::cout << "aligned_alloc of the accessor policy data failed\n";
+    return 1;
+  }
+  Extend_bench const policy_extents{policy_rows, policy_columns};
+
+  stdex::mdspan md_default(policy_data, policy_extents);
+  stdex::mdspan<int, Extend_bench, stdex::layout_right,
+                streaming_accessor<int>>
+      md_streaming(policy_data, policy_extents);
+  stdex::mdspan<int, Extend_bench, stdex::layout_right,
+                aligned_accessor<int, policy_alignment>>
+      md_aligned(policy_data, policy_extents);
+
+  int const expected_policy_sum = policy_rows * policy_columns;
+  bool policy_check = true;
+  auto const measure_fill = [&](char const *name, auto m) {
+    std::fill_n(policy_data, policy_rows * policy_columns, 0);
+    auto const start = std::chrono::steady_clock::now();
+    iterate_over_all_elements(m);
+    auto const time = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    std::cout << "fill with " << name << ": " << time << " ms\n";
+    policy_check &= reduce_elements_impl(SimpleSpan{md_default}) ==
+                    expected_policy_sum;
+  };
+
+  measure_fill("default_accessor", md_default);
+  measure_fill("streaming_accessor", md_streaming);
+  measure_fill("aligned_accessor", md_aligned);
+
+  policy_check &= measure("reduce with default_accessor", [&]() {
+                    return reduce_elements(md_default);
+                  }) == expected_policy_sum;
+  policy_check &= measure("reduce with aligned_accessor", [&]() {
+                    return reduce_elements(md_aligned);
+                  }) == expected_policy_sum;
+
+  // A submdspan of the aligned mdspan starts at an offset pointer, therefore
+  // it uses the offset_policy (default_accessor) of the aligned_accessor.
+  auto const md_aligned_rows = stdex::submdspan(
+      md_aligned, std::pair{std::size_t{1}, std::size_t{3}}, stdex::full_extent);
+  static_assert(
+      std::is_same_v<decltype(md_aligned_rows)::accessor_type,
+                     stdex::default_accessor<int>>,
+      "the submdspan of an aligned mdspan uses the default_accessor");
+  policy_check &= reduce_elements(md_aligned_rows) ==
+                  static_cast<int>(2 * policy_columns);
+
+  std::free(policy_data);
+
+  if (policy_check) {
+    std::cout << "all accessor policies have the same result\n";
+  } else {
+    std::cout << "the accessor policies have different results\n";
+  }
+
   std::cout << "\n";
 
   return 0;
@@ -1,7 +1,9 @@
 #include "compute_cuda.hpp"
 #include "compute_hip.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <future>
 #include <iostream>
-#include <thread>
 #include <vector>
 
 struct HipMatrix {
@@ -42,25 +44,27 @@ int main() {
     cuda_results.emplace_back(size, 0);
   }
 
-  std::vector<std::thread> threads;
+  // a worker for each GPU, so that all GPUs compute at the same time
+  ThreadPool pool(std::max(number_amd_gpus + number_nvidia_gpus, 1));
+  std::vector<std::future<void>> futures;
 
   for (int dev = 0; dev < number_amd_gpus; ++dev) {
     std::cout << "Run matrix multiplication on AMD GPU Nr. " << dev << "\n";
     HipMatrix j(dim, hip_results[dev]);
-    threads.emplace_back(j, dev);
+    futures.push_back(pool.submit(j, dev));
   }
 
   for (int dev = 0; dev < number_nvidia_gpus; ++dev) {
     std::cout << "Run matrix multiplication on NVIDIA GPU Nr. " << dev << "\n";
     CudaMatrix j(dim, cuda_results[dev]);
-    threads.emplace_back(j, dev);
+    futures.push_back(pool.submit(j, dev));
   }
 
-  for (std::thread &t : threads) {
-    t.join();
+  for (std::future<void> &f : futures) {
+    f.get();
   }
 
-  std::cout << "all threads are joined\n";
+  std::cout << "all jobs are done\n";
 
   return 0;
 }
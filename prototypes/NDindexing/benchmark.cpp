@@ -0,0 +1,98 @@
+#include <chrono>
+#include <iostream>
+
+#include "ndim.hpp"
+#include "ndim_layout.hpp"
+#include "fixed_ndim.hpp"
+#include "static_ndim.hpp"
+
+// Compares the linear -> multi dimensional conversion of the compile time layout with the runtime versions. Each
+// benchmark sums up all coordinates, so that the compiler cannot remove the conversion. Build with optimization
+// (e.g. -DCMAKE_BUILD_TYPE=Release), otherwise the fold expressions of the compile time layout are not inlined.
+
+/// @brief Measure the runtime of func and print it.
+/// @param name Name of the benchmark.
+/// @param func Function, which returns a checksum.
+/// @return Runtime in milliseconds.
+template<typename TFunc>
+double measure(char const * name, TFunc && func){
+   auto const start = std::chrono::steady_clock::now();
+   unsigned long long const checksum = func();
+   double const time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+   std::cout << "  " << name << ": " << time << " ms (checksum " << checksum << ")" << std::endl;
+   return time;
+}
+
+template<unsigned int... Dims>
+void benchmark(unsigned int const repetitions){
+   using layout = static_ndim::NDimLayout<Dims...>;
+   NDim const nDdimsize{Dims...};
+   NDimLayout const runtime_layout(nDdimsize);
+   NDimLayout const fast_layout(nDdimsize, DivisionMode::fast);
+   fixed::NDim<layout::rank> const fixed_dimsize{Dims...};
+
+   std::cout << "to_multi " << nDdimsize << " (" << layout::total_elements << " elements, " << repetitions
+             << " repetitions)" << std::endl;
+
+   auto const sum_up = [](auto const & nDposition, unsigned int const rank){
+      unsigned long long sum = 0;
+      for(unsigned int dim = 1; dim <= rank; ++dim){
+         sum += nDposition.at(dim);
+      }
+      return sum;
+   };
+
+   double const runtime_time = measure("NDimLayout hardware division", [&](){
+      unsigned long long checksum = 0;
+      NDim nDposition(layout::rank, 0);
+      for(unsigned int r = 0; r < repetitions; ++r){
+         for(unsigned int i = 0; i < layout::total_elements; ++i){
+            runtime_layout.to_multi(i, nDposition);
+            checksum += sum_up(nDposition, layout::rank);
+         }
+      }
+      return checksum;
+   });
+
+   measure("NDimLayout fast division", [&](){
+      unsigned long long checksum = 0;
+      NDim nDposition(layout::rank, 0);
+      for(unsigned int r = 0; r < repetitions; ++r){
+         for(unsigned int i = 0; i < layout::total_elements; ++i){
+            fast_layout.to_multi(i, nDposition);
+            checksum += sum_up(nDposition, layout::rank);
+         }
+      }
+      return checksum;
+   });
+
+   measure("fixed::get_multi_index_v2", [&](){
+      unsigned long long checksum = 0;
+      for(unsigned int r = 0; r < repetitions; ++r){
+         for(unsigned int i = 0; i < layout::total_elements; ++i){
+            checksum += sum_up(get_multi_index_v2(i, fixed_dimsize), layout::rank);
+         }
+      }
+      return checksum;
+   });
+
+   double const static_time = measure("static_ndim::Layout", [&](){
+      unsigned long long checksum = 0;
+      for(unsigned int r = 0; r < repetitions; ++r){
+         for(unsigned int i = 0; i < layout::total_elements; ++i){
+            checksum += sum_up(layout::to_multi(i), layout::rank);
+         }
+      }
+      return checksum;
+   });
+
+   std::cout << "  speedup static_ndim::Layout over NDimLayout: " << runtime_time / static_time << std::endl;
+}
+
+int main(int argc, char **argv){
+   // powers of two: the divisions become shifts
+   benchmark<8, 16, 16, 16, 16>(20);
+   // other sizes: the divisions become multiplications with the reciprocal
+   benchmark<7, 13, 11, 17, 19>(20);
+   return 0;
+}
@@ -0,0 +1,120 @@
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+#include "ndim.hpp"
+#include "fixed_ndim.hpp"
+#include "static_ndim.hpp"
+#include "mapping_test_suite.hpp"
+
+template<typename TIndex, unsigned int Rank, std::size_t Size>
+void print_mapping(std::array<std::pair<fixed::NDim<Rank, TIndex>, TIndex>, Size> const & mapping){
+   for(auto [multi_index, linear_index] : mapping){
+      std::cout << multi_index << " -> " << linear_index << std::endl;
+   }
+}
+
+template<typename TIndex, unsigned int Rank, std::size_t Size>
+void print_mapping(std::array<std::pair<TIndex, fixed::NDim<Rank, TIndex>>, Size> const & mapping){
+   for(auto [linear_index, multi_index] : mapping){
+      std::cout << linear_index << " -> " << multi_index << std::endl;
+   }
+}
+
+/// @brief Print the dimensions and the number of elements like to1D() of runtime.cpp.
+template<typename TLayout>
+void print_layout(){
+   std::cout << "dimensions: ";
+   for(unsigned int dim = TLayout::rank; dim > 0; --dim){
+      std::cout << TLayout::dimsize.at(dim) << ", ";
+   }
+   std::cout << std::endl;
+
+   std::cout << "total elements: " << TLayout::total_elements << std::endl;
+}
+
+// ################################################################################################
+// ### compile time checks
+// ################################################################################################
+
+using Layout4D = static_ndim::NDimLayout<2, 4, 3, 5>;
+
+static_assert(Layout4D::total_elements == 120);
+static_assert(Layout4D::step_length == std::array<unsigned int, 4>{60, 15, 5, 1});
+static_assert(Layout4D::to_linear(fixed::NDim{1, 2, 0, 3}) == 1 * 60 + 2 * 15 + 0 * 5 + 3);
+static_assert(Layout4D::to_multi(93) == fixed::NDim{1, 2, 0, 3});
+static_assert(static_ndim::toND<Layout4D>[93].second == fixed::NDim{1, 2, 0, 3});
+static_assert(static_ndim::to1D<Layout4D>[93].second == 93);
+static_assert(static_ndim::Layout<std::uint64_t, 65537, 65536>::to_linear(fixed::NDim<2, std::uint64_t>{65536, 65535}) == UINT64_C(4295032831));
+
+/// @brief Checks that each linear index survives the round trip through both mappings at compile time.
+template<typename TLayout>
+constexpr bool is_round_trip(){
+   for(typename TLayout::index_type i = 0; i < TLayout::total_elements; ++i){
+      if(TLayout::to_linear(TLayout::to_multi(i)) != i){
+         return false;
+      }
+   }
+   return true;
+}
+
+static_assert(is_round_trip<static_ndim::NDimLayout<7>>());
+static_assert(is_round_trip<static_ndim::NDimLayout<3, 1, 4, 2, 5>>());
+static_assert(is_round_trip<static_ndim::NDimLayout<3, 7, 1, 5, 11>>());
+
+// ################################################################################################
+// ### shared test suite
+// ################################################################################################
+
+/// @brief Runs the mapping test suite, which is shared with runtime.cpp, on the compile time layout.
+template<unsigned int... Dims>
+bool check_static_layout(std::integer_sequence<unsigned int, Dims...> shape){
+   using layout = static_ndim::NDimLayout<Dims...>;
+   NDim const nDdimsize = mapping_test_suite::to_ndim(shape);
+
+   auto const to_linear = [](NDim const & nDposition){
+      typename layout::position_type position;
+      for(unsigned int dim = 1; dim <= layout::rank; ++dim){
+         position.at(dim) = nDposition.at(dim);
+      }
+      return layout::to_linear(position);
+   };
+   auto const to_multi = [](unsigned int const linear_index){ return layout::to_multi(linear_index); };
+
+   bool equal = mapping_test_suite::check_mapping("static_ndim::Layout", nDdimsize, to_linear, to_multi);
+
+   // the precalculated mapping needs to be equal, too
+   auto const & mapping = static_ndim::toND<layout>;
+   auto const to_multi_table = [&mapping](unsigned int const linear_index){ return mapping[linear_index].second; };
+   equal &= mapping_test_suite::check_mapping("static_ndim::toND", nDdimsize, to_linear, to_multi_table);
+   return equal;
+}
+
+int main(int argc, char **argv){
+   print_layout<static_ndim::NDimLayout<2>>();
+   print_mapping(static_ndim::to1D<static_ndim::NDimLayout<2>>);
+
+   std::cout << std::endl;
+   print_layout<static_ndim::NDimLayout<2, 3>>();
+   print_mapping(static_ndim::to1D<static_ndim::NDimLayout<2, 3>>);
+
+   std::cout << std::endl;
+   print_layout<static_ndim::NDimLayout<2, 3, 5>>();
+   print_mapping(static_ndim::to1D<static_ndim::NDimLayout<2, 3, 5>>);
+
+   std::cout << std::endl;
+   print_layout<Layout4D>();
+   print_mapping(static_ndim::to1D<Layout4D>);
+
+   std::cout << std::endl;
+   print_mapping(static_ndim::toND<Layout4D>);
+
+   std::cout << std::endl;
+   bool equal = true;
+   mapping_test_suite::for_each_shape([&](auto shape){
+      equal &= check_static_layout(shape);
+   });
+
+   return equal ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+/// @brief Replaces the integer division by a constant divisor with a multiplication and a shift. The reciprocal
+///        (magic number) is calculated once, therefore it is only faster if the same divisor is used many times.
+///
+/// The implementation uses the 64 bit reciprocal from Lemire, Kaser and Kurz (https://arxiv.org/abs/1902.01961):
+/// M = floor((2^64 - 1) / d) + 1
+/// n / d = (M * n) >> 64
+/// The result is exact for each 32 bit n and d > 1. d = 1 is handled separately, because M would need 65 bits.
+class FastDivider {
+   std::uint64_t m_magic = 0;
+   unsigned int m_divisor = 1;
+
+   static std::uint64_t mul_high(std::uint64_t const a, std::uint64_t const b){
+#if defined(__SIZEOF_INT128__)
+      return static_cast<std::uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#else
+      std::uint64_t const a_low = a & 0xFFFFFFFF;
+      std::uint64_t const a_high = a >> 32;
+      std::uint64_t const b_low = b & 0xFFFFFFFF;
+      std::uint64_t const b_high = b >> 32;
+
+      std::uint64_t const low_low = a_low * b_low;
+      std::uint64_t const high_low = a_high * b_low;
+      std::uint64_t const low_high = a_low * b_high;
+      std::uint64_t const high_high = a_high * b_high;
+
+      std::uint64_t const middle = (low_low >> 32) + (high_low & 0xFFFFFFFF) + (low_high & 0xFFFFFFFF);
+      return high_high + (high_low >> 32) + (low_high >> 32) + (middle >> 32);
+#endif
+   }
+
+public:
+   FastDivider() = default;
+
+   /// @brief Calculate the magic number of the divisor.
+   /// @param divisor Divisor, needs to be larger than 0.
+   explicit FastDivider(unsigned int const divisor) : m_divisor(divisor) {
+      assert(divisor > 0 && "Division by zero.");
+      if(divisor > 1){
+         m_magic = UINT64_C(0xFFFFFFFFFFFFFFFF) / divisor + 1;
+      }
+   }
+
+   unsigned int get_divisor() const {
+      return m_divisor;
+   }
+
+   /// @brief Return the reciprocal, e.g. for SIMD implementations. Is 0 for the divisor 1.
+   std::uint64_t get_magic() const {
+      return m_magic;
+   }
+
+   /// @brief Calculate n / divisor without hardware division.
+   /// @param n Dividend.
+   /// @return Quotient, which is rounded down like the C++ integer division.
+   unsigned int divide(unsigned int const n) const {
+      if(m_magic == 0){
+         return n;
+      }
+      return static_cast<unsigned int>(mul_high(m_magic, n));
+   }
+};
+
+/// @brief 64 bit version of FastDivider. Uses the same algorithm with a 128 bit reciprocal:
+/// M = floor((2^128 - 1) / d) + 1
+/// n / d = (M * n) >> 128
+/// Falls back to the hardware division, if the compiler does not support 128 bit integers.
+class FastDivider64 {
+#if defined(__SIZEOF_INT128__)
+   unsigned __int128 m_magic = 0;
+#endif
+   std::uint64_t m_divisor = 1;
+
+public:
+   FastDivider64() = default;
+
+   /// @brief Calculate the magic number of the divisor.
+   /// @param divisor Divisor, needs to be larger than 0.
+   explicit FastDivider64(std::uint64_t const divisor) : m_divisor(divisor) {
+      assert(divisor > 0 && "Division by zero.");
+#if defined(__SIZEOF_INT128__)
+      if(divisor > 1){
+         m_magic = ~static_cast<unsigned __int128>(0) / divisor + 1;
+      }
+#endif
+   }
+
+   std::uint64_t get_divisor() const {
+      return m_divisor;
+   }
+
+   /// @brief Calculate n / divisor without hardware division.
+   /// @param n Dividend.
+   /// @return Quotient, which is rounded down like the C++ integer division.
+   std::uint64_t divide(std::uint64_t const n) const {
+#if defined(__SIZEOF_INT128__)
+      if(m_magic == 0){
+         return n;
+      }
+      // (M * n) >> 128 = (M_high * n + ((M_low * n) >> 64)) >> 64
+      unsigned __int128 const low = (static_cast<unsigned __int128>(static_cast<std::uint64_t>(m_magic)) * n) >> 64;
+      unsigned __int128 const high = static_cast<unsigned __int128>(static_cast<std::uint64_t>(m_magic >> 64)) * n;
+      return static_cast<std::uint64_t>((high + low) >> 64);
+#else
+      return n / m_divisor;
+#endif
+   }
+};
+
+/// @brief Select the FastDivider, which fits to the index type.
+template<typename TIndex>
+using FastDividerFor = std::conditional_t<(sizeof(TIndex) > sizeof(unsigned int)), FastDivider64, FastDivider>;
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <ostream>
+#include <type_traits>
+
+/// @brief Versions of NDim and the index functions, where the number of dimensions is known at compile time.
+///        The values are stored on the stack and all loops over the dimensions can be unrolled by the compiler.
+namespace fixed {
+
+   /// @brief Stores n dimensional coordinate system with a compile time number of dimensions.
+   /// @tparam Rank Number of dimensions.
+   /// @tparam TIndex Unsigned integer type of the index (see ::BasicNDim).
+   template<unsigned int Rank, typename TIndex = unsigned int>
+   class NDim {
+      static_assert(Rank > 0, "Zero dimensions are not allowed.");
+      static_assert(std::is_integral_v<TIndex> && std::is_unsigned_v<TIndex>, "TIndex needs to be an unsigned integer.");
+
+      std::array<TIndex, Rank> m_dim_arr{};
+   public:
+      using index_type = TIndex;
+
+      /// @brief Create n dimensional coordinate system where each dim is 0.
+      constexpr NDim() = default;
+
+      /// @brief Create n dimensional coordinate system like the initializer list constructor of ::NDim.
+      /// @param dim The largest dimension is stored left and the smallest right.
+      template<typename... TDim>
+      requires (sizeof...(TDim) == Rank && (std::is_integral_v<TDim> && ...))
+      constexpr NDim(TDim... dim) : m_dim_arr{static_cast<TIndex>(dim)...} {}
+
+      /// @brief Return size of dimensions.
+      /// @param index Dimension.
+      /// @return Return size of dimensions.
+      constexpr TIndex & at(unsigned int index){
+         assert(index > 0);
+         assert(index <= Rank);
+         return m_dim_arr[Rank - index];
+      }
+
+      constexpr TIndex at(unsigned int index) const{
+         assert(index > 0);
+         assert(index <= Rank);
+         return m_dim_arr[Rank - index];
+      }
+
+      /// @brief Raw access to the values. The largest dimension is stored first and the smallest dimension last.
+      /// @return Pointer to the first (largest) dimension.
+      constexpr TIndex * data(){
+         return m_dim_arr.data();
+      }
+
+      constexpr TIndex const * data() const{
+         return m_dim_arr.data();
+      }
+
+      static constexpr unsigned int get_dim() {
+         return Rank;
+      }
+
+      /// @brief Multiply the number of each dimension.
+      /// @return Total number of elements
+      constexpr TIndex get_total_elements() const {
+         TIndex total_elements = 1;
+         for(TIndex elements : m_dim_arr){
+            total_elements *= elements;
+         }
+         return total_elements;
+      }
+
+      constexpr bool operator==(NDim const & other) const = default;
+   };
+
+   template<typename... TDim>
+   NDim(TDim...) -> NDim<sizeof...(TDim)>;
+
+   template<unsigned int Rank, typename TIndex>
+   std::ostream & operator<<(std::ostream & os, NDim<Rank, TIndex> const & nDim){
+      os << "[";
+      for(auto dim = Rank; dim > 0; --dim){
+         os << nDim.at(dim);
+         if (dim > 1){
+            os << " ";
+         }
+      }
+      os << "]";
+      return os;
+   }
+
+   /// @brief Calculate the linear index from an n dimensional index. Uses the Horner scheme of the formula
+   ///        Index = xn ( D{n-1} * ... * D1  ) + x{n-1} ( D{n-2} * ... * D1 ) + ... + x2 * D1 + x1
+   /// @param nDposition Position in the in the n dimensional index.
+   /// @param nDdimsize Size of each dimension.
+   /// @return Linear index.
+   template<unsigned int Rank, typename TIndex>
+   constexpr TIndex get_linear_index(NDim<Rank, TIndex> const & nDposition, NDim<Rank, TIndex> const & nDdimsize){
+      TIndex const * position = nDposition.data();
+      TIndex const * dimsize = nDdimsize.data();
+
+      TIndex linear_index = position[0];
+      for(unsigned int i = 1; i < Rank; ++i){
+         linear_index = linear_index * dimsize[i] + position[i];
+      }
+      return linear_index;
+   }
+
+   /// @brief Calculate the multi dimensional index from a linear index with modulo (version 1). Instead
+   ///        subtracting the index of the smaller dimensions, the rest index is divided by each dimension size,
+   ///        which gives the same result.
+   /// @param linear_index The linear index
+   /// @param nDdimsize Size of each dimension.
+   /// @return multi dimensional index
+   template<unsigned int Rank, typename TIndex>
+   constexpr NDim<Rank, TIndex> get_multi_index(std::type_identity_t<TIndex> linear_index, NDim<Rank, TIndex> const & nDdimsize){
+      NDim<Rank, TIndex> nDposition;
+      TIndex * position = nDposition.data();
+      TIndex const * dimsize = nDdimsize.data();
+
+      for(unsigned int i = Rank; i > 0; --i){
+         position[i - 1] = linear_index % dimsize[i - 1];
+         linear_index /= dimsize[i - 1];
+      }
+      return nDposition;
+   }
+
+   /// @brief Calculate the multi dimensional index from a linear index with integer division (version 2).
+   /// @param linear_index The linear index
+   /// @param nDdimsize Size of each dimension.
+   /// @return multi dimensional index
+   template<unsigned int Rank, typename TIndex>
+   constexpr NDim<Rank, TIndex> get_multi_index_v2(std::type_identity_t<TIndex> linear_index, NDim<Rank, TIndex> const & nDdimsize){
+      TIndex const * dimsize = nDdimsize.data();
+
+      std::array<TIndex, Rank> step_length{};
+      step_length[Rank - 1] = 1;
+      for(unsigned int i = Rank - 1; i > 0; --i){
+         step_length[i - 1] = step_length[i] * dimsize[i];
+      }
+
+      NDim<Rank, TIndex> nDposition;
+      TIndex * position = nDposition.data();
+      for(unsigned int i = 0; i < Rank - 1; ++i){
+         position[i] = linear_index / step_length[i];
+         linear_index -= position[i] * step_length[i];
+      }
+      position[Rank - 1] = linear_index;
+      return nDposition;
+   }
+
+} // namespace fixed
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+#include "ndim.hpp"
+#include "ndim_iterator.hpp"
+
+/// @brief Test suite, which is shared by runtime.cpp and compile.cpp. Both versions are compared with the same
+///        reference on the same index rooms, therefore they produce identical mappings if the suite is passed.
+namespace mapping_test_suite {
+
+   /// @brief Call func with each index room of the test suite. The dimension sizes are passed as
+   ///        std::integer_sequence, so that they can be used as template arguments or at runtime.
+   /// @param func Function, which accepts std::integer_sequence<unsigned int, Dims...>.
+   template<typename TFunc>
+   void for_each_shape(TFunc && func){
+      func(std::integer_sequence<unsigned int, 7>{});
+      func(std::integer_sequence<unsigned int, 2, 3>{});
+      func(std::integer_sequence<unsigned int, 2, 3, 5>{});
+      func(std::integer_sequence<unsigned int, 2, 4, 3, 5>{});
+      func(std::integer_sequence<unsigned int, 3, 1, 4, 2, 5>{});
+      func(std::integer_sequence<unsigned int, 3, 7, 1, 5, 11>{});
+      func(std::integer_sequence<unsigned int, 8, 16, 16, 16>{});
+   }
+
+   /// @brief Create a NDim from the dimension sizes of for_each_shape().
+   template<unsigned int... Dims>
+   NDim to_ndim(std::integer_sequence<unsigned int, Dims...>){
+      return NDim{Dims...};
+   }
+
+   /// @brief Compares a mapping with the odometer order of NDimRange for each element of the index room. The
+   ///        reference does not use any division, therefore it is independent of both implementations.
+   /// @param name Name of the implementation, which is printed.
+   /// @param nDdimsize Dimension sizes of the multi dimensional index.
+   /// @param to_linear Function, which maps a NDim to the linear index.
+   /// @param to_multi Function, which maps a linear index to a type with the method at(dim) like NDim.
+   /// @return True, if all results are equal.
+   template<typename TToLinear, typename TToMulti>
+   bool check_mapping(std::string_view name, NDim const & nDdimsize, TToLinear const & to_linear, TToMulti const & to_multi){
+      bool equal = true;
+      for(auto const [linear_index, expected] : NDimRange(nDdimsize)){
+         auto const nDposition = to_multi(linear_index);
+         for(unsigned int dim = 1; dim <= nDdimsize.get_dim(); ++dim){
+            if(nDposition.at(dim) != expected.at(dim)){
+               equal = false;
+               std::cout << name << " to_multi(" << linear_index << ") != " << expected << std::endl;
+               break;
+            }
+         }
+         if(to_linear(expected) != linear_index){
+            equal = false;
+            std::cout << name << " to_linear(" << expected << ") != " << linear_index << std::endl;
+         }
+      }
+      std::cout << name << " " << nDdimsize << (equal ? " passes " : " fails ") << "the mapping test suite" << std::endl;
+      return equal;
+   }
+
+} // namespace mapping_test_suite
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cassert>
+#include <initializer_list>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// @brief Stores n dimensional coordinate system. 
+/// @tparam TIndex Unsigned integer type of the index. unsigned int is the fastest type but can only address 4 Gi
+///         elements. Use std::uint64_t for larger index rooms.
+template<typename TIndex>
+class BasicNDim {
+   static_assert(std::is_integral_v<TIndex> && std::is_unsigned_v<TIndex>, "TIndex needs to be an unsigned integer.");
+
+   std::vector<TIndex> m_dim_vec;
+public:
+   using index_type = TIndex;
+
+   BasicNDim() = default;
+   
+   /// @brief Create n dimensional coordinate system from a initializer list, like a std::vector.
+   /// @param dim The largest dimension is stored left and the smallest left. 
+   BasicNDim(std::initializer_list<TIndex> dim) : m_dim_vec{dim} {}
+   
+   /// @brief Create n dimensional coordinate system and initialize each dim with the same value.
+   /// @param dim Number of dimensions.
+   /// @param initial_value Initial value.
+   BasicNDim(unsigned int dim, TIndex initial_value) : m_dim_vec(dim, initial_value) {}
+
+
+   /// @brief Return size of dimensions. Does boundary checks.
+   /// @param index Dimension.
+   /// @return Return size of dimensions.
+   TIndex & at(unsigned int index){
+      assert(index > 0);
+      assert(index <= m_dim_vec.size());
+      return m_dim_vec.at(m_dim_vec.size() - index);
+   }
+
+   TIndex at(unsigned int index) const{
+      assert(index > 0);
+      assert(index <= m_dim_vec.size());
+      return m_dim_vec.at(m_dim_vec.size() - index);
+   }
+
+   /// @brief Raw access to the values without boundary checks. The largest dimension is stored first and the
+   ///        smallest dimension last, therefore `data()[get_dim() - 1]` is the same like `at(1)`.
+   /// @return Pointer to the first (largest) dimension.
+   TIndex * data(){
+      return m_dim_vec.data();
+   }
+
+   TIndex const * data() const{
+      return m_dim_vec.data();
+   }
+
+   unsigned int get_dim() const {
+      return m_dim_vec.size();
+   }
+
+   /// @brief Multiply the number of each dimension.
+   /// @return Total number of elements
+   TIndex get_total_elements() const {
+      TIndex total_elements = 1;
+      for(TIndex elements : m_dim_vec){
+         total_elements *= elements;
+      }
+      return total_elements;
+   }
+
+   bool operator==(BasicNDim const & other) const{
+      if(get_dim() != other.get_dim()){
+         return false;
+      }
+
+      for(unsigned int dim = 1; dim <= get_dim(); ++dim){
+         if (at(dim) != other.at(dim)){
+            return false;
+         }
+      }
+      return true;
+   }
+};
+
+/// @brief n dimensional coordinate system with 32 bit index.
+using NDim = BasicNDim<unsigned int>;
+
+template<typename TIndex>
+std::ostream & operator<<(std::ostream & os, BasicNDim<TIndex> const & nDim){
+   os << "[";
+   for(auto dim = nDim.get_dim(); dim > 0; --dim){
+      os << nDim.at(dim);
+      if (dim > 1){
+         os << " ";
+      }
+   }
+   os << "]";
+   return os;
+}
+
+template<typename TIndex>
+std::ostream & operator<<(std::ostream & os, std::pair<TIndex, BasicNDim<TIndex>> const & linearNDim){
+   return os << "<" << linearNDim.first << ", " << linearNDim.second << ">";
+}
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define NDINDEXING_X86_SIMD 1
+#include <immintrin.h>
+#else
+#define NDINDEXING_X86_SIMD 0
+#endif
+
+#include "fast_division.hpp"
+#include "ndim.hpp"
+#include "ndim_layout.hpp"
+
+/// @brief Stores many multi dimensional indices as structure of arrays. Each dimension has its own coordinate
+///        buffer, therefore the SIMD kernels can store a whole register of coordinates at once.
+class NDimBatch {
+   // same ordering like the data of NDim: the coordinates of the largest dimension are stored first
+   std::vector<std::vector<unsigned int>> m_coordinates;
+   std::size_t m_size = 0;
+
+public:
+   NDimBatch() = default;
+
+   /// @brief Allocate the coordinate buffers.
+   /// @param dim Number of dimensions.
+   /// @param size Number of multi dimensional indices.
+   NDimBatch(unsigned int const dim, std::size_t const size) : m_coordinates(dim, std::vector<unsigned int>(size)), m_size(size) {}
+
+   unsigned int get_dim() const {
+      return m_coordinates.size();
+   }
+
+   std::size_t size() const {
+      return m_size;
+   }
+
+   /// @brief Return coordinate buffer of a dimension.
+   /// @param dim Dimension, same counting like NDim::at().
+   /// @return Coordinates of all indices in the dimension dim.
+   std::span<unsigned int> at(unsigned int const dim){
+      assert(dim > 0);
+      assert(dim <= get_dim());
+      return m_coordinates[get_dim() - dim];
+   }
+
+   std::span<unsigned int const> at(unsigned int const dim) const{
+      assert(dim > 0);
+      assert(dim <= get_dim());
+      return m_coordinates[get_dim() - dim];
+   }
+
+   /// @brief Collect the coordinates of a single index.
+   /// @param index Position in the batch.
+   /// @return Multi dimensional index.
+   NDim get(std::size_t const index) const {
+      NDim nDposition(get_dim(), 0);
+      for(unsigned int i = 0; i < get_dim(); ++i){
+         nDposition.data()[i] = m_coordinates[i][index];
+      }
+      return nDposition;
+   }
+
+   /// @brief Return pointers to the coordinate buffers, ordered like the data of NDim.
+   /// @param offset Offset of each pointer.
+   /// @return Pointer to each coordinate buffer.
+   std::vector<unsigned int *> data(std::size_t const offset = 0){
+      std::vector<unsigned int *> pointers(get_dim());
+      for(unsigned int i = 0; i < get_dim(); ++i){
+         pointers[i] = m_coordinates[i].data() + offset;
+      }
+      return pointers;
+   }
+};
+
+/// @brief Instruction set of the batch kernels.
+enum class SimdLevel {
+   scalar,
+   avx2,
+   avx512
+};
+
+inline char const * get_simd_level_name(SimdLevel const level){
+   switch(level){
+      case SimdLevel::avx512: return "avx512";
+      case SimdLevel::avx2: return "avx2";
+      default: return "scalar";
+   }
+}
+
+/// @brief Return best instruction set, which is supported by the CPU.
+inline SimdLevel detect_simd_level(){
+#if NDINDEXING_X86_SIMD
+   if(__builtin_cpu_supports("avx512f")){
+      return SimdLevel::avx512;
+   }
+   if(__builtin_cpu_supports("avx2")){
+      return SimdLevel::avx2;
+   }
+#endif
+   return SimdLevel::scalar;
+}
+
+namespace detail {
+
+   /// @brief Step length and reciprocal of each dimension except the smallest one, which has always step length 1.
+   struct BatchStepLength {
+      std::vector<unsigned int> step_length;
+      std::vector<FastDivider> divider;
+
+      explicit BatchStepLength(NDimLayout const & layout){
+         for(unsigned int dim = layout.get_dim(); dim > 1; --dim){
+            unsigned int const length = layout.get_step_length(dim);
+            step_length.push_back(length);
+            // the step length is 0, if a smaller dimension size is 0, but then there is no valid linear index
+            divider.emplace_back(length > 0 ? length : 1);
+         }
+      }
+   };
+
+   /// @brief Convert the linear indices in [begin, end). The SIMD kernels use it for the remaining elements, which
+   ///        do not fill a register.
+   inline void to_multi_batch_scalar(BatchStepLength const & steps, unsigned int const * linear_indices,
+                                     std::size_t const begin, std::size_t const end,
+                                     unsigned int * const * coordinates){
+      std::size_t const last = steps.step_length.size();
+      for(std::size_t i = begin; i < end; ++i){
+         unsigned int rest = linear_indices[i];
+         for(std::size_t d = 0; d < last; ++d){
+            unsigned int const pos = steps.divider[d].divide(rest);
+            coordinates[d][i] = pos;
+            rest -= pos * steps.step_length[d];
+         }
+         coordinates[last][i] = rest;
+      }
+   }
+
+#if NDINDEXING_X86_SIMD
+   // The reciprocal M has 64 bit, but the SIMD units can only multiply 32 bit x 32 bit -> 64 bit. Therefore, the
+   // product is split: (M * n) >> 64 = (M_high * n + ((M_low * n) >> 32)) >> 32
+
+   __attribute__((target("avx2")))
+   inline __m256i mul_high_avx2(__m256i const x, __m256i const magic_low, __m256i const magic_high){
+      __m256i const low = _mm256_srli_epi64(_mm256_mul_epu32(x, magic_low), 32);
+      __m256i const high = _mm256_mul_epu32(x, magic_high);
+      return _mm256_srli_epi64(_mm256_add_epi64(high, low), 32);
+   }
+
+   __attribute__((target("avx2")))
+   inline __m256i divide_avx2(__m256i const n, __m256i const magic_low, __m256i const magic_high){
+      // _mm256_mul_epu32 uses only the even 32 bit lanes
+      __m256i const q_even = mul_high_avx2(n, magic_low, magic_high);
+      __m256i const q_odd = mul_high_avx2(_mm256_srli_epi64(n, 32), magic_low, magic_high);
+      return _mm256_blend_epi32(q_even, _mm256_slli_epi64(q_odd, 32), 0b10101010);
+   }
+
+   __attribute__((target("avx2")))
+   inline void to_multi_batch_avx2(BatchStepLength const & steps, unsigned int const * linear_indices,
+                                   std::size_t const size, unsigned int * const * coordinates){
+      std::size_t const last = steps.step_length.size();
+      std::size_t constexpr lanes = 8;
+      std::size_t const vector_size = size - size % lanes;
+
+      for(std::size_t i = 0; i < vector_size; i += lanes){
+         __m256i rest = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(linear_indices + i));
+         for(std::size_t d = 0; d < last; ++d){
+            __m256i pos;
+            if(steps.step_length[d] == 1){
+               pos = rest;
+            } else {
+               std::uint64_t const magic = steps.divider[d].get_magic();
+               pos = divide_avx2(rest, _mm256_set1_epi64x(magic & 0xFFFFFFFF), _mm256_set1_epi64x(magic >> 32));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(coordinates[d] + i), pos);
+            rest = _mm256_sub_epi32(rest, _mm256_mullo_epi32(pos, _mm256_set1_epi32(static_cast<int>(steps.step_length[d]))));
+         }
+         _mm256_storeu_si256(reinterpret_cast<__m256i *>(coordinates[last] + i), rest);
+      }
+
+      to_multi_batch_scalar(steps, linear_indices, vector_size, size, coordinates);
+   }
+
+   // The unmasked AVX-512 shifts and multiplications of GCC pass an undefined vector as merge source, which
+   // triggers -Wmaybe-uninitialized. The zero masking forms with all lanes set compile to the same instructions.
+   inline constexpr __mmask8 all_64bit_lanes = 0xFF;
+
+   __attribute__((target("avx512f")))
+   inline __m512i mul_high_avx512(__m512i const x, __m512i const magic_low, __m512i const magic_high){
+      __m512i const low = _mm512_maskz_srli_epi64(all_64bit_lanes,
+                                                  _mm512_maskz_mul_epu32(all_64bit_lanes, x, magic_low), 32);
+      __m512i const high = _mm512_maskz_mul_epu32(all_64bit_lanes, x, magic_high);
+      return _mm512_maskz_srli_epi64(all_64bit_lanes, _mm512_add_epi64(high, low), 32);
+   }
+
+   __attribute__((target("avx512f")))
+   inline __m512i divide_avx512(__m512i const n, __m512i const magic_low, __m512i const magic_high){
+      __m512i const q_even = mul_high_avx512(n, magic_low, magic_high);
+      __m512i const q_odd = mul_high_avx512(_mm512_maskz_srli_epi64(all_64bit_lanes, n, 32), magic_low, magic_high);
+      return _mm512_mask_blend_epi32(0xAAAA, q_even, _mm512_maskz_slli_epi64(all_64bit_lanes, q_odd, 32));
+   }
+
+   __attribute__((target("avx512f")))
+   inline void to_multi_batch_avx512(BatchStepLength const & steps, unsigned int const * linear_indices,
+                                     std::size_t const size, unsigned int * const * coordinates){
+      std::size_t const last = steps.step_length.size();
+      std::size_t constexpr lanes = 16;
+      std::size_t const vector_size = size - size % lanes;
+
+      for(std::size_t i = 0; i < vector_size; i += lanes){
+         __m512i rest = _mm512_loadu_si512(linear_indices + i);
+         for(std::size_t d = 0; d < last; ++d){
+            __m512i pos;
+            if(steps.step_length[d] == 1){
+               pos = rest;
+            } else {
+               std::uint64_t const magic = steps.divider[d].get_magic();
+               pos = divide_avx512(rest, _mm512_set1_epi64(magic & 0xFFFFFFFF), _mm512_set1_epi64(magic >> 32));
+            }
+            _mm512_storeu_si512(coordinates[d] + i, pos);
+            rest = _mm512_sub_epi32(rest, _mm512_mullo_epi32(pos, _mm512_set1_epi32(static_cast<int>(steps.step_length[d]))));
+         }
+         _mm512_storeu_si512(coordinates[last] + i, rest);
+      }
+
+      to_multi_batch_scalar(steps, linear_indices, vector_size, size, coordinates);
+   }
+#endif
+
+   inline void to_multi_batch(BatchStepLength const & steps, unsigned int const * linear_indices,
+                              std::size_t const size, unsigned int * const * coordinates, SimdLevel const level){
+#if NDINDEXING_X86_SIMD
+      if(level == SimdLevel::avx512){
+         to_multi_batch_avx512(steps, linear_indices, size, coordinates);
+         return;
+      }
+      if(level == SimdLevel::avx2){
+         to_multi_batch_avx2(steps, linear_indices, size, coordinates);
+         return;
+      }
+#endif
+      to_multi_batch_scalar(steps, linear_indices, 0, size, coordinates);
+   }
+
+} // namespace detail
+
+/// @brief Calculate the multi dimensional indices of many linear indices with SIMD instructions. Uses the
+///        algorithm of version 2 with precalculated reciprocals (see FastDivider), because there is no SIMD integer
+///        division.
+/// @param layout Layout of the index room.
+/// @param linear_indices The linear indices.
+/// @param nDpositions Stores the results. Needs to have the same size and number of dimensions like linear_indices
+///        and the layout.
+/// @param level Instruction set. Needs to be supported by the CPU.
+inline void to_multi_batch(NDimLayout const & layout, std::span<unsigned int const> linear_indices,
+                           NDimBatch & nDpositions, SimdLevel const level = detect_simd_level()){
+   assert(nDpositions.get_dim() == layout.get_dim());
+   assert(nDpositions.size() == linear_indices.size());
+   detail::BatchStepLength const steps(layout);
+   detail::to_multi_batch(steps, linear_indices.data(), linear_indices.size(), nDpositions.data().data(), level);
+}
+
+/// @brief Maps all possible linear index to multi dimensional indices in the index room of nDdimsize. Same result
+///        like toND_v2(), but the multi dimensional indices are stored as structure of arrays and calculated with
+///        SIMD instructions. The linear index of a multi dimensional index is the position in the batch.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @param level Instruction set. Needs to be supported by the CPU.
+/// @return Multi dimensional index of each linear index.
+inline NDimBatch toND_v2_batch(NDim const & nDdimsize, SimdLevel const level = detect_simd_level()){
+   NDimLayout const layout(nDdimsize);
+   detail::BatchStepLength const steps(layout);
+   std::size_t const total_elements = layout.get_total_elements();
+   NDimBatch nDpositions(layout.get_dim(), total_elements);
+
+   // generate the linear indices in small blocks, which stay in the L1 cache
+   std::size_t constexpr block_size = 1024;
+   std::array<unsigned int, block_size> linear_indices;
+   // the pointers are allocated once and moved forward by each block
+   std::vector<unsigned int *> coordinates = nDpositions.data();
+   for(std::size_t begin = 0; begin < total_elements; begin += block_size){
+      std::size_t const size = std::min(block_size, total_elements - begin);
+      for(std::size_t i = 0; i < size; ++i){
+         linear_indices[i] = static_cast<unsigned int>(begin + i);
+      }
+      detail::to_multi_batch(steps, linear_indices.data(), size, coordinates.data(), level);
+      for(unsigned int * & c : coordinates){
+         c += size;
+      }
+   }
+   return nDpositions;
+}
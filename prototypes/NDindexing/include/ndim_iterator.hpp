@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "ndim.hpp"
+#include "ndim_layout.hpp"
+
+/// @brief Iterates over all positions of an index room in the order of the linear index. The multi dimensional
+///        index is incremented like an odometer: increment the smallest dimension and carry over to the next
+///        larger dimension, if the dimension size is reached. Therefore, the next position costs amortized O(1)
+///        without any division. Only the jumps (operator+=, operator-=, operator[]) calculate the multi dimensional
+///        index from the linear index again.
+///
+///        The iterator provides all operations of a random access iterator (jumps, distance, comparison and
+///        operator[]) in O(1). But it only models std::bidirectional_iterator: operator* returns a proxy, which refers
+///        to the multi dimensional index stored in the iterator. operator[] cannot return such a proxy, because the
+///        jumped iterator is a temporary, therefore it returns a copy (value_type). For the same reason,
+///        iterator_category is std::input_iterator_tag, because the legacy forward iterator requires a real reference.
+///
+///        The end iterator has the multi dimensional index {dimsize[0], 0, ..., 0}, which is the position after
+///        the increment of the last element. Therefore, the end iterator can be decremented.
+/// @tparam TIndex Unsigned integer type of the index (see BasicNDim).
+template<typename TIndex>
+class BasicNDimIterator {
+   BasicNDimLayout<TIndex> const * m_layout = nullptr;
+   BasicNDim<TIndex> m_position;
+   TIndex m_linear_index = 0;
+
+   /// @brief Set the multi dimensional index from the linear index. Clamps the linear index to [0, total elements].
+   void set_position(std::ptrdiff_t const linear_index){
+      std::ptrdiff_t const total = static_cast<std::ptrdiff_t>(m_layout->get_total_elements());
+      assert(linear_index >= 0 && linear_index <= total);
+      m_linear_index = static_cast<TIndex>(std::clamp<std::ptrdiff_t>(linear_index, 0, total));
+      if(m_linear_index < m_layout->get_total_elements()){
+         m_layout->to_multi(m_linear_index, m_position);
+      } else {
+         TIndex * position = m_position.data();
+         std::fill(position, position + m_position.get_dim(), TIndex{0});
+         if(m_position.get_dim() > 0){
+            position[0] = m_layout->get_dimsize().data()[0];
+         }
+      }
+   }
+
+public:
+   using iterator_concept = std::bidirectional_iterator_tag;
+   using iterator_category = std::input_iterator_tag;
+   using value_type = std::pair<TIndex, BasicNDim<TIndex>>;
+   using difference_type = std::ptrdiff_t;
+   // the multi dimensional index is only valid until the iterator is changed
+   using reference = std::pair<TIndex, BasicNDim<TIndex> const &>;
+
+   BasicNDimIterator() = default;
+
+   /// @brief Create iterator at a position of the index room.
+   /// @param layout Layout of the index room. Needs to live longer than the iterator.
+   /// @param linear_index Start position. Can be the total number of elements for the end iterator.
+   BasicNDimIterator(BasicNDimLayout<TIndex> const & layout, TIndex const linear_index)
+      : m_layout(&layout), m_position(layout.get_dim(), 0) {
+      set_position(static_cast<difference_type>(linear_index));
+   }
+
+   TIndex get_linear_index() const {
+      return m_linear_index;
+   }
+
+   BasicNDim<TIndex> const & get_multi_index() const {
+      return m_position;
+   }
+
+   reference operator*() const {
+      return {m_linear_index, m_position};
+   }
+
+   /// @brief Position n elements after the iterator. Returns a copy of the multi dimensional index, because there is
+   ///        no iterator, which owns it.
+   value_type operator[](difference_type const n) const {
+      BasicNDimIterator const it = *this + n;
+      return {it.m_linear_index, it.m_position};
+   }
+
+   BasicNDimIterator & operator++(){
+      ++m_linear_index;
+      TIndex * position = m_position.data();
+      TIndex const * dimsize = m_layout->get_dimsize().data();
+      for(unsigned int i = m_layout->get_dim() - 1; i > 0; --i){
+         if(++position[i] < dimsize[i]){
+            return *this;
+         }
+         position[i] = 0;
+      }
+      // the largest dimension has no carry, it is only larger than the dimension size for the end iterator
+      ++position[0];
+      return *this;
+   }
+
+   BasicNDimIterator operator++(int){
+      BasicNDimIterator old = *this;
+      ++(*this);
+      return old;
+   }
+
+   BasicNDimIterator & operator--(){
+      assert(m_linear_index > 0);
+      --m_linear_index;
+      TIndex * position = m_position.data();
+      TIndex const * dimsize = m_layout->get_dimsize().data();
+      for(unsigned int i = m_layout->get_dim() - 1; i > 0; --i){
+         if(position[i] > 0){
+            --position[i];
+            return *this;
+         }
+         position[i] = dimsize[i] - 1;
+      }
+      --position[0];
+      return *this;
+   }
+
+   BasicNDimIterator operator--(int){
+      BasicNDimIterator old = *this;
+      --(*this);
+      return old;
+   }
+
+   /// @brief Jump n positions. Calculates the multi dimensional index with a single conversion from the linear
+   ///        index. The position is clamped to [begin, end].
+   BasicNDimIterator & operator+=(difference_type const n){
+      set_position(static_cast<difference_type>(m_linear_index) + n);
+      return *this;
+   }
+
+   BasicNDimIterator & operator-=(difference_type const n){
+      return *this += -n;
+   }
+
+   friend BasicNDimIterator operator+(BasicNDimIterator it, difference_type const n){
+      return it += n;
+   }
+
+   friend BasicNDimIterator operator+(difference_type const n, BasicNDimIterator it){
+      return it += n;
+   }
+
+   friend BasicNDimIterator operator-(BasicNDimIterator it, difference_type const n){
+      return it -= n;
+   }
+
+   friend difference_type operator-(BasicNDimIterator const & lhs, BasicNDimIterator const & rhs){
+      return static_cast<difference_type>(lhs.m_linear_index) - static_cast<difference_type>(rhs.m_linear_index);
+   }
+
+   // the linear index identifies the position, therefore compare only the linear index
+   friend bool operator==(BasicNDimIterator const & lhs, BasicNDimIterator const & rhs){
+      return lhs.m_linear_index == rhs.m_linear_index;
+   }
+
+   friend auto operator<=>(BasicNDimIterator const & lhs, BasicNDimIterator const & rhs){
+      return lhs.m_linear_index <=> rhs.m_linear_index;
+   }
+};
+
+// The proxy reference and the value type need a common reference to model std::indirectly_readable. C++23 provides
+// it for all pairs, C++20 needs the specializations.
+template<typename TIndex, template<typename> class TQual, template<typename> class UQual>
+struct std::basic_common_reference<std::pair<TIndex, BasicNDim<TIndex> const &>, std::pair<TIndex, BasicNDim<TIndex>>, TQual, UQual> {
+   using type = std::pair<TIndex, BasicNDim<TIndex> const &>;
+};
+
+template<typename TIndex, template<typename> class TQual, template<typename> class UQual>
+struct std::basic_common_reference<std::pair<TIndex, BasicNDim<TIndex>>, std::pair<TIndex, BasicNDim<TIndex> const &>, TQual, UQual> {
+   using type = std::pair<TIndex, BasicNDim<TIndex> const &>;
+};
+
+/// @brief Range over all positions of an index room. Generates each pair of linear and multi dimensional index on
+///        demand instead of storing all of them like toND() or to1D().
+///
+/// for(auto [linear_index, nDposition] : NDimRange(NDim{2, 4, 3, 5})){ ... }
+///
+/// The iterators point to the layout of the range, therefore the range needs to live longer than its iterators.
+/// The range is a std::ranges::view and can be combined with the views of the standard library.
+/// @tparam TIndex Unsigned integer type of the index (see BasicNDim).
+template<typename TIndex>
+class BasicNDimRange : public std::ranges::view_interface<BasicNDimRange<TIndex>> {
+   BasicNDimLayout<TIndex> m_layout;
+
+public:
+   explicit BasicNDimRange(BasicNDim<TIndex> const & nDdimsize) : m_layout(nDdimsize) {}
+
+   explicit BasicNDimRange(BasicNDimLayout<TIndex> layout) : m_layout(std::move(layout)) {}
+
+   BasicNDimLayout<TIndex> const & get_layout() const {
+      return m_layout;
+   }
+
+   TIndex size() const {
+      return m_layout.get_total_elements();
+   }
+
+   BasicNDimIterator<TIndex> begin() const {
+      return BasicNDimIterator<TIndex>(m_layout, 0);
+   }
+
+   BasicNDimIterator<TIndex> end() const {
+      return BasicNDimIterator<TIndex>(m_layout, m_layout.get_total_elements());
+   }
+};
+
+using NDimIterator = BasicNDimIterator<unsigned int>;
+using NDimRange = BasicNDimRange<unsigned int>;
+
+static_assert(std::bidirectional_iterator<NDimIterator>);
+static_assert(std::ranges::view<NDimRange>);
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cassert>
+#include <limits>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "fast_division.hpp"
+#include "ndim.hpp"
+
+/// @brief Algorithm, which is used for the divisions of the linear -> multi dimensional index conversion.
+enum class DivisionMode {
+   /// @brief Use the integer division of the hardware.
+   hardware,
+   /// @brief Use precalculated reciprocals of the step lengths (see FastDivider). Avoids the expensive hardware
+   ///        division but requires some extra memory and time during construction.
+   fast
+};
+
+/// @brief Defines, if the layout checks that the total number of elements can be stored in the index type.
+enum class OverflowCheck {
+   /// @brief The product of the dimension sizes silently wraps around.
+   unchecked,
+   /// @brief Throw std::overflow_error during construction of the layout, if the product of the dimension sizes
+   ///        does not fit in the index type. If the check is passed, each valid linear index and each step length
+   ///        is smaller than the total number of elements, therefore the conversions do not need to check again.
+   checked
+};
+
+/// @brief Precalculates the step length of each dimension of an index room (see version 2 in the README) and
+///        converts indices iterative without memory allocations.
+///
+/// The recursive implementations in runtime.cpp calculate the product of the smaller dimensions in each recursion
+/// step again. The layout calculates the products once, therefore a conversion costs only one multiplication (and
+/// one division for linear -> multi) per dimension.
+///
+/// stepLenght{n} = D{n-1} * ... * D1
+/// stepLenght{1} = 1
+///
+/// @tparam TIndex Unsigned integer type of the index (see BasicNDim).
+template<typename TIndex>
+class BasicNDimLayout {
+   using divider_type = FastDividerFor<TIndex>;
+
+   BasicNDim<TIndex> m_dimsize;
+   // same ordering like the data of NDim: the step length of the largest dimension is stored first
+   std::vector<TIndex> m_step_length;
+   // only filled, if m_division_mode is DivisionMode::fast
+   std::vector<divider_type> m_step_divider;
+   TIndex m_total_elements = 1;
+   DivisionMode m_division_mode = DivisionMode::hardware;
+
+   template<DivisionMode Mode>
+   void to_multi_impl(TIndex linear_index, BasicNDim<TIndex> & nDposition) const {
+      assert(nDposition.get_dim() == get_dim());
+      TIndex * position = nDposition.data();
+      unsigned int const last = get_dim() - 1;
+      for(unsigned int i = 0; i < last; ++i){
+         TIndex pos;
+         if constexpr (Mode == DivisionMode::fast){
+            pos = m_step_divider[i].divide(linear_index);
+         } else {
+            pos = linear_index / m_step_length[i];
+         }
+         position[i] = pos;
+         linear_index -= pos * m_step_length[i];
+      }
+      // the step length of the smallest dimension is always 1
+      position[last] = linear_index;
+   }
+
+   template<DivisionMode Mode>
+   void to_multi_impl(std::span<TIndex const> linear_indices, std::span<BasicNDim<TIndex>> nDpositions) const {
+      assert(nDpositions.size() == linear_indices.size());
+      for(std::size_t i = 0; i < linear_indices.size(); ++i){
+         to_multi_impl<Mode>(linear_indices[i], nDpositions[i]);
+      }
+   }
+
+public:
+   using index_type = TIndex;
+
+   /// @brief Calculate the step length of each dimension.
+   /// @param nDdimsize Size of each dimension.
+   /// @param division_mode Algorithm of the divisions in to_multi().
+   /// @param overflow_check Check if the total number of elements fits in TIndex.
+   explicit BasicNDimLayout(BasicNDim<TIndex> const & nDdimsize,
+                            DivisionMode const division_mode = DivisionMode::hardware,
+                            OverflowCheck const overflow_check = OverflowCheck::unchecked)
+      : m_dimsize(nDdimsize), m_step_length(nDdimsize.get_dim()), m_division_mode(division_mode) {
+      assert(nDdimsize.get_dim() > 0 && "Zero dimensions are not allowed.");
+
+      TIndex step_length = 1;
+      for(unsigned int dim = 1; dim <= m_dimsize.get_dim(); ++dim){
+         m_step_length[m_dimsize.get_dim() - dim] = step_length;
+         TIndex const dimsize = m_dimsize.at(dim);
+         if(overflow_check == OverflowCheck::checked && dimsize != 0
+            && step_length > std::numeric_limits<TIndex>::max() / dimsize){
+            std::stringstream ss;
+            ss << "The number of elements of the index room " << m_dimsize << " does not fit in a "
+               << sizeof(TIndex) * 8 << " bit index.";
+            throw std::overflow_error(ss.str());
+         }
+         step_length *= dimsize;
+      }
+      m_total_elements = step_length;
+
+      if(m_division_mode == DivisionMode::fast){
+         m_step_divider.reserve(m_step_length.size());
+         for(TIndex const length : m_step_length){
+            // the step length is 0, if a smaller dimension size is 0, but then there is no valid linear index
+            m_step_divider.emplace_back(length > 0 ? length : 1);
+         }
+      }
+   }
+
+   DivisionMode get_division_mode() const {
+      return m_division_mode;
+   }
+
+   unsigned int get_dim() const {
+      return m_dimsize.get_dim();
+   }
+
+   BasicNDim<TIndex> const & get_dimsize() const {
+      return m_dimsize;
+   }
+
+   TIndex get_total_elements() const {
+      return m_total_elements;
+   }
+
+   /// @brief Return step length of a dimension.
+   /// @param dim Dimension, same counting like NDim::at().
+   /// @return Product of all dimension sizes smaller than dim.
+   TIndex get_step_length(unsigned int dim) const {
+      assert(dim > 0);
+      assert(dim <= get_dim());
+      return m_step_length[get_dim() - dim];
+   }
+
+   /// @brief Calculate the linear index from an n dimensional index.
+   /// @param nDposition Position in the n dimensional index. Needs to have the same number of dimensions like the
+   ///        layout.
+   /// @return Linear index.
+   TIndex to_linear(BasicNDim<TIndex> const & nDposition) const {
+      assert(nDposition.get_dim() == get_dim());
+      TIndex const * position = nDposition.data();
+      TIndex linear_index = 0;
+      for(unsigned int i = 0; i < get_dim(); ++i){
+         linear_index += position[i] * m_step_length[i];
+      }
+      return linear_index;
+   }
+
+   /// @brief Calculate the multi dimensional index from a linear index and store it in an existing NDim. Does not
+   ///        allocate memory.
+   /// @param linear_index The linear index.
+   /// @param nDposition Stores the result. Needs to have the same number of dimensions like the layout.
+   void to_multi(TIndex linear_index, BasicNDim<TIndex> & nDposition) const {
+      if(m_division_mode == DivisionMode::fast){
+         to_multi_impl<DivisionMode::fast>(linear_index, nDposition);
+      } else {
+         to_multi_impl<DivisionMode::hardware>(linear_index, nDposition);
+      }
+   }
+
+   /// @brief Calculate the multi dimensional index from a linear index.
+   /// @param linear_index The linear index.
+   /// @return multi dimensional index
+   BasicNDim<TIndex> to_multi(TIndex linear_index) const {
+      BasicNDim<TIndex> nDposition(get_dim(), 0);
+      to_multi(linear_index, nDposition);
+      return nDposition;
+   }
+
+   /// @brief Calculate the linear index of many n dimensional indices.
+   /// @param nDpositions Positions in the n dimensional index.
+   /// @param linear_indices Stores the results. Needs to have the same size like nDpositions.
+   void to_linear(std::span<BasicNDim<TIndex> const> nDpositions, std::span<TIndex> linear_indices) const {
+      assert(nDpositions.size() == linear_indices.size());
+      for(std::size_t i = 0; i < nDpositions.size(); ++i){
+         linear_indices[i] = to_linear(nDpositions[i]);
+      }
+   }
+
+   /// @brief Calculate the multi dimensional index of many linear indices.
+   /// @param linear_indices The linear indices.
+   /// @param nDpositions Stores the results. Needs to have the same size like linear_indices and each NDim needs to
+   ///        have the same number of dimensions like the layout, so that no memory is allocated.
+   void to_multi(std::span<TIndex const> linear_indices, std::span<BasicNDim<TIndex>> nDpositions) const {
+      // select the division algorithm once for all indices
+      if(m_division_mode == DivisionMode::fast){
+         to_multi_impl<DivisionMode::fast>(linear_indices, nDpositions);
+      } else {
+         to_multi_impl<DivisionMode::hardware>(linear_indices, nDpositions);
+      }
+   }
+};
+
+/// @brief Layout with 32 bit index.
+using NDimLayout = BasicNDimLayout<unsigned int>;
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <execution>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ndim.hpp"
+#include "ndim_iterator.hpp"
+#include "ndim_layout.hpp"
+
+// The parallel versions split the linear index range in chunks. Each chunk calculates the multi dimensional index of
+// its first element once and increments it afterwards like an odometer (see NDimIterator). Because each mapping
+// entry is independent, the result is identical to the serial versions.
+
+/// @brief Default number of elements of a chunk. The 4096 mapping entries of a chunk need 128 KiB (without the heap
+///        memory of NDim), which fits in the L2 cache.
+inline unsigned int constexpr default_chunk_size = 4096;
+
+namespace detail {
+
+   /// @brief Number of chunks, rounded up. Does not overflow for total_elements near the maximum of the index type,
+   ///        unlike (total_elements + chunk_size - 1) / chunk_size.
+   inline unsigned int get_number_of_chunks(unsigned int const total_elements, unsigned int const chunk_size){
+      return total_elements / chunk_size + (total_elements % chunk_size != 0);
+   }
+
+   /// @brief End of the chunk, which starts at begin. Does not overflow like begin + chunk_size.
+   inline unsigned int get_chunk_end(unsigned int const begin, unsigned int const chunk_size, unsigned int const total_elements){
+      return begin + std::min(chunk_size, total_elements - begin);
+   }
+
+   /// @brief Call func(begin, end) for each chunk of the index range [0, total_elements).
+   /// @param total_elements Size of the index range.
+   /// @param chunk_size Maximum size of each chunk.
+   /// @param number_of_threads Number of worker threads. The threads take the next free chunk, so that the load is
+   ///        balanced, if chunks need different time.
+   /// @param func Function, which is called with the begin and end index of a chunk.
+   template<typename TFunc>
+   void parallel_for_chunks(unsigned int const total_elements, unsigned int const chunk_size,
+                            unsigned int const number_of_threads, TFunc const & func){
+      assert(chunk_size > 0);
+      assert(number_of_threads > 0);
+      unsigned int const number_of_chunks = get_number_of_chunks(total_elements, chunk_size);
+      std::atomic<unsigned int> next_chunk = 0;
+
+      auto const worker = [&](){
+         for(unsigned int chunk = next_chunk++; chunk < number_of_chunks; chunk = next_chunk++){
+            unsigned int const begin = chunk * chunk_size;
+            func(begin, get_chunk_end(begin, chunk_size, total_elements));
+         }
+      };
+
+      std::vector<std::thread> threads;
+      auto const join_all = [&threads](){
+         for(std::thread & t : threads){
+            t.join();
+         }
+      };
+      try {
+         for(unsigned int t = 1; t < std::min(number_of_threads, number_of_chunks); ++t){
+            threads.emplace_back(worker);
+         }
+         // the calling thread is also a worker
+         worker();
+      } catch(...) {
+         // A joinable std::thread calls std::terminate in its destructor. The started threads finish the remaining
+         // chunks, therefore they can be joined before the exception is passed on.
+         join_all();
+         throw;
+      }
+      join_all();
+   }
+
+   /// @brief Same like the std::thread version, but the chunks are distributed by a parallel algorithm of the
+   ///        standard library.
+   template<typename TExecutionPolicy, typename TFunc>
+   void parallel_for_chunks(TExecutionPolicy && policy, unsigned int const total_elements,
+                            unsigned int const chunk_size, TFunc const & func){
+      assert(chunk_size > 0);
+      unsigned int const number_of_chunks = get_number_of_chunks(total_elements, chunk_size);
+      std::vector<unsigned int> chunks(number_of_chunks);
+      for(unsigned int chunk = 0; chunk < number_of_chunks; ++chunk){
+         chunks[chunk] = chunk;
+      }
+      std::for_each(std::forward<TExecutionPolicy>(policy), chunks.begin(), chunks.end(), [&](unsigned int const chunk){
+         unsigned int const begin = chunk * chunk_size;
+         func(begin, get_chunk_end(begin, chunk_size, total_elements));
+      });
+   }
+
+   /// @brief Returns a function, which fills the entries [begin, end) of a toND mapping.
+   inline auto fill_toND_chunk(NDimLayout const & layout, std::vector<std::pair<unsigned int, NDim>> & mapping){
+      return [&layout, &mapping](unsigned int const begin, unsigned int const end){
+         NDimIterator it(layout, begin);
+         for(unsigned int i = begin; i < end; ++i, ++it){
+            mapping[i] = std::pair<unsigned int, NDim>(it.get_linear_index(), it.get_multi_index());
+         }
+      };
+   }
+
+   /// @brief Returns a function, which fills the entries [begin, end) of a to1D mapping.
+   inline auto fill_to1D_chunk(NDimLayout const & layout, std::vector<std::pair<NDim, unsigned int>> & mapping){
+      return [&layout, &mapping](unsigned int const begin, unsigned int const end){
+         NDimIterator it(layout, begin);
+         for(unsigned int i = begin; i < end; ++i, ++it){
+            mapping[i] = std::pair<NDim, unsigned int>(it.get_multi_index(), it.get_linear_index());
+         }
+      };
+   }
+
+} // namespace detail
+
+/// @brief Parallel version of toND_v2(), which uses number_of_threads std::threads.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @param number_of_threads Number of threads.
+/// @param chunk_size Number of elements, which are calculated at once by a thread.
+/// @return Mapping mappings from linear coordinate to multi dimensional coordinate.
+inline std::vector<std::pair<unsigned int, NDim>> toND_v2_parallel(NDim const & nDdimsize,
+                                                                   unsigned int const number_of_threads = std::thread::hardware_concurrency(),
+                                                                   unsigned int const chunk_size = default_chunk_size){
+   NDimLayout const layout(nDdimsize);
+   std::vector<std::pair<unsigned int, NDim>> mapping(layout.get_total_elements());
+   detail::parallel_for_chunks(layout.get_total_elements(), chunk_size, std::max(number_of_threads, 1u),
+                               detail::fill_toND_chunk(layout, mapping));
+   return mapping;
+}
+
+/// @brief Parallel version of toND_v2(), which uses a parallel algorithm of the standard library. libstdc++ needs to
+///        be linked against TBB, otherwise the algorithm runs serial.
+/// @param policy Execution policy, e.g. std::execution::par.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @param chunk_size Number of elements, which are calculated at once by a thread.
+/// @return Mapping mappings from linear coordinate to multi dimensional coordinate.
+template<typename TExecutionPolicy>
+requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>>
+std::vector<std::pair<unsigned int, NDim>> toND_v2_parallel(TExecutionPolicy && policy, NDim const & nDdimsize,
+                                                            unsigned int const chunk_size = default_chunk_size){
+   NDimLayout const layout(nDdimsize);
+   std::vector<std::pair<unsigned int, NDim>> mapping(layout.get_total_elements());
+   detail::parallel_for_chunks(std::forward<TExecutionPolicy>(policy), layout.get_total_elements(), chunk_size,
+                               detail::fill_toND_chunk(layout, mapping));
+   return mapping;
+}
+
+/// @brief Parallel version of to1D(), which uses number_of_threads std::threads.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @param number_of_threads Number of threads.
+/// @param chunk_size Number of elements, which are calculated at once by a thread.
+/// @return Mapping mappings from multi dimensional coordinate to linear coordinate.
+inline std::vector<std::pair<NDim, unsigned int>> to1D_parallel(NDim const & nDdimsize,
+                                                                unsigned int const number_of_threads = std::thread::hardware_concurrency(),
+                                                                unsigned int const chunk_size = default_chunk_size){
+   NDimLayout const layout(nDdimsize);
+   std::vector<std::pair<NDim, unsigned int>> mapping(layout.get_total_elements());
+   detail::parallel_for_chunks(layout.get_total_elements(), chunk_size, std::max(number_of_threads, 1u),
+                               detail::fill_to1D_chunk(layout, mapping));
+   return mapping;
+}
+
+/// @brief Parallel version of to1D(), which uses a parallel algorithm of the standard library.
+/// @param policy Execution policy, e.g. std::execution::par.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @param chunk_size Number of elements, which are calculated at once by a thread.
+/// @return Mapping mappings from multi dimensional coordinate to linear coordinate.
+template<typename TExecutionPolicy>
+requires std::is_execution_policy_v<std::remove_cvref_t<TExecutionPolicy>>
+std::vector<std::pair<NDim, unsigned int>> to1D_parallel(TExecutionPolicy && policy, NDim const & nDdimsize,
+                                                         unsigned int const chunk_size = default_chunk_size){
+   NDimLayout const layout(nDdimsize);
+   std::vector<std::pair<NDim, unsigned int>> mapping(layout.get_total_elements());
+   detail::parallel_for_chunks(std::forward<TExecutionPolicy>(policy), layout.get_total_elements(), chunk_size,
+                               detail::fill_to1D_chunk(layout, mapping));
+   return mapping;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cassert>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include <version>
+
+#include "ndim.hpp"
+#include "ndim_iterator.hpp"
+
+// The views generate the mapping pairs on demand. Therefore, they do not need memory for the whole index room and
+// can be combined with the views of the standard library, e.g. std::views::filter or std::views::take.
+
+/// @brief Stores all elements of a view in a std::vector. Uses std::ranges::to, if the standard library supports
+///        it (C++23).
+/// @param range Input range.
+/// @return Vector with all elements.
+template<std::ranges::input_range TRange>
+auto to_vector(TRange && range){
+#if defined(__cpp_lib_ranges_to_container)
+   return std::ranges::to<std::vector>(std::forward<TRange>(range));
+#else
+   std::vector<std::ranges::range_value_t<TRange>> vec;
+   if constexpr (std::ranges::sized_range<TRange>){
+      vec.reserve(std::ranges::size(range));
+   }
+   for(auto && element : range){
+      vec.push_back(std::forward<decltype(element)>(element));
+   }
+   return vec;
+#endif
+}
+
+namespace views {
+
+   /// @brief Split a view in chunks with chunk_size elements. The last chunk can be smaller. Uses std::views::chunk,
+   ///        if the standard library supports it (C++23).
+   /// @param view A random access view, e.g. views::toND().
+   /// @param chunk_size Number of elements of each chunk.
+   /// @return View of views.
+   template<std::ranges::view TView>
+   requires std::ranges::random_access_range<TView> && std::ranges::sized_range<TView>
+   auto chunk(TView view, std::ranges::range_difference_t<TView> const chunk_size){
+      assert(chunk_size > 0);
+#if defined(__cpp_lib_ranges_chunk)
+      return std::views::chunk(std::move(view), chunk_size);
+#else
+      auto const size = static_cast<std::ranges::range_difference_t<TView>>(std::ranges::size(view));
+      auto const number_of_chunks = (size + chunk_size - 1) / chunk_size;
+      // drop and take are O(1) for random access views
+      return std::views::iota(std::ranges::range_difference_t<TView>{0}, number_of_chunks)
+             | std::views::transform([view = std::move(view), chunk_size](auto const chunk_index){
+                  return view | std::views::drop(chunk_index * chunk_size) | std::views::take(chunk_size);
+               });
+#endif
+   }
+
+   /// @brief Lazy version of to1D(). Generates each position of the index room in the ordering of the linear index
+   ///        with the odometer of NDimRange, therefore no division is required.
+   /// @param nDdimsize Dimension sizes of the multi dimensional index.
+   /// @return View of pairs of multi dimensional and linear coordinate.
+   inline auto to1D(NDim const & nDdimsize){
+      assert(nDdimsize.get_dim() > 0 && "Zero dimensions are not allowed.");
+      return NDimRange(nDdimsize)
+             | std::views::transform([](auto const & position){
+                  return std::pair<NDim, unsigned int>(position.second, position.first);
+               });
+   }
+
+   /// @brief Maps each linear index of the index room to a multi dimensional index with to_multi. Base of the lazy
+   ///        versions of toND() and toND_v2(), which only differ in the conversion function.
+   /// @param nDdimsize Dimension sizes of the multi dimensional index.
+   /// @param to_multi Function `NDim(unsigned int linear_index, NDim const & nDdimsize)`.
+   /// @return Random access view of pairs of linear and multi dimensional coordinate.
+   template<typename TToMulti>
+   auto linear_to_multi(NDim nDdimsize, TToMulti to_multi){
+      unsigned int const total_elements = nDdimsize.get_total_elements();
+      return std::views::iota(0u, total_elements)
+             | std::views::transform([nDdimsize = std::move(nDdimsize), to_multi](unsigned int const i){
+                  return std::pair(i, to_multi(i, nDdimsize));
+               });
+   }
+
+} // namespace views
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "fixed_ndim.hpp"
+
+/// @brief Compile time version of the index mappings. The dimension sizes are template arguments, therefore the
+///        step lengths are constants and all loops are unrolled with fold expressions. The compiler replaces the
+///        divisions by the constant step lengths with multiplications and shifts (or only shifts for powers of
+///        two), so that a conversion compiles to straight-line code without any branch or hardware division.
+namespace static_ndim {
+
+   /// @brief Index room with dimension sizes, which are known at compile time.
+   /// @tparam TIndex Unsigned integer type of the index (see ::BasicNDim).
+   /// @tparam Dims Dimension sizes in the same order like the initializer list constructor of ::NDim: the largest
+   ///         dimension is the first argument and the smallest the last.
+   template<typename TIndex, TIndex... Dims>
+   class Layout {
+      static_assert(sizeof...(Dims) > 0, "Zero dimensions are not allowed.");
+
+      static constexpr std::array<TIndex, sizeof...(Dims)> calculate_step_length(){
+         std::array<TIndex, sizeof...(Dims)> const dimsize{Dims...};
+         std::array<TIndex, sizeof...(Dims)> step_length{};
+         step_length[sizeof...(Dims) - 1] = 1;
+         for(std::size_t i = sizeof...(Dims) - 1; i > 0; --i){
+            step_length[i - 1] = step_length[i] * dimsize[i];
+         }
+         return step_length;
+      }
+
+      template<std::size_t... I>
+      static constexpr TIndex to_linear_impl(TIndex const * position, std::index_sequence<I...>){
+         return ((position[I] * step_length[I]) + ...);
+      }
+
+      template<std::size_t... I>
+      static constexpr void to_multi_impl(TIndex linear_index, TIndex * position, std::index_sequence<I...>){
+         // step_length[I] is a constant expression in each unrolled step
+         ((position[I] = linear_index / step_length[I], linear_index -= position[I] * step_length[I]), ...);
+      }
+
+   public:
+      using index_type = TIndex;
+      using position_type = fixed::NDim<sizeof...(Dims), TIndex>;
+
+      static constexpr unsigned int rank = sizeof...(Dims);
+      static constexpr position_type dimsize{Dims...};
+      static constexpr TIndex total_elements = (Dims * ...);
+      /// @brief Same ordering like the data of NDim: the step length of the largest dimension is stored first.
+      static constexpr std::array<TIndex, rank> step_length = calculate_step_length();
+
+      /// @brief Calculate the linear index from an n dimensional index.
+      /// @param nDposition Position in the in the n dimensional index.
+      /// @return Linear index.
+      static constexpr TIndex to_linear(position_type const & nDposition){
+         return to_linear_impl(nDposition.data(), std::make_index_sequence<rank>{});
+      }
+
+      /// @brief Calculate the multi dimensional index from a linear index (version 2).
+      /// @param linear_index The linear index
+      /// @return multi dimensional index
+      static constexpr position_type to_multi(TIndex const linear_index){
+         position_type nDposition;
+         to_multi_impl(linear_index, nDposition.data(), std::make_index_sequence<rank>{});
+         return nDposition;
+      }
+   };
+
+   /// @brief Layout with 32 bit index.
+   template<unsigned int... Dims>
+   using NDimLayout = Layout<unsigned int, Dims...>;
+
+   /// @brief Mapping from multi dimensional coordinate to linear coordinate, which is calculated at compile time.
+   template<typename TLayout>
+   constexpr auto make_to1D(){
+      std::array<std::pair<typename TLayout::position_type, typename TLayout::index_type>, TLayout::total_elements> mapping{};
+      for(typename TLayout::index_type i = 0; i < TLayout::total_elements; ++i){
+         auto const nDposition = TLayout::to_multi(i);
+         mapping[i] = {nDposition, TLayout::to_linear(nDposition)};
+      }
+      return mapping;
+   }
+
+   /// @brief Mapping from linear coordinate to multi dimensional coordinate, which is calculated at compile time.
+   template<typename TLayout>
+   constexpr auto make_toND(){
+      std::array<std::pair<typename TLayout::index_type, typename TLayout::position_type>, TLayout::total_elements> mapping{};
+      for(typename TLayout::index_type i = 0; i < TLayout::total_elements; ++i){
+         mapping[i] = {i, TLayout::to_multi(i)};
+      }
+      return mapping;
+   }
+
+   /// @brief The mappings are stored in the read only data of the binary. No calculation is left for the runtime.
+   template<typename TLayout>
+   inline constexpr auto to1D = make_to1D<TLayout>();
+
+   template<typename TLayout>
+   inline constexpr auto toND = make_toND<TLayout>();
+
+} // namespace static_ndim
@@ -1,84 +1,25 @@
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <utility>
 #include <cassert>
 #include <stdexcept>
 #include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <version>
 
-/// @brief Stores n dimensional coordinate system. 
-class NDim {
-   std::vector<unsigned int> m_dim_vec;
-public:
-   NDim() = default;
-   
-   /// @brief Create n dimensional coordinate system from a initializer list, like a std::vector.
-   /// @param dim The largest dimension is stored left and the smallest left. 
-   NDim(std::initializer_list<unsigned int> dim) : m_dim_vec{dim} {}
-   
-   /// @brief Create n dimensional coordinate system and initialize each dim with the same value.
-   /// @param dim Number of dimensions.
-   /// @param initial_value Initial value.
-   NDim(unsigned int dim, unsigned int initial_value) : m_dim_vec(dim, initial_value) {}
-
-
-   /// @brief Return size of dimensions. Does boundary checks.
-   /// @param index Dimension.
-   /// @return Return size of dimensions.
-   unsigned int & at(unsigned int index){
-      assert(index > 0);
-      assert(index <= m_dim_vec.size());
-      return m_dim_vec.at(m_dim_vec.size() - index);
-   }
-
-   unsigned int at(unsigned int index) const{
-      assert(index > 0);
-      assert(index <= m_dim_vec.size());
-      return m_dim_vec.at(m_dim_vec.size() - index);
-   }
-
-   unsigned int get_dim() const {
-      return m_dim_vec.size();
-   }
-
-   /// @brief Multiply the number of each dimension.
-   /// @return Total number of elements
-   unsigned int get_total_elements() const {
-      unsigned int total_elements = 1;
-      for(unsigned int elements : m_dim_vec){
-         total_elements *= elements;
-      }
-      return total_elements;
-   }
-
-   bool operator==(NDim const & other) const{
-      if(get_dim() != other.get_dim()){
-         return false;
-      }
-
-      for(auto dim = 1; dim <= get_dim(); ++dim){
-         if (at(dim) != other.at(dim)){
-            return false;
-         }
-      }
-      return true;
-   }
-};
-
-std::ostream & operator<<(std::ostream & os, NDim const & nDim){
-   os << "[";
-   for(auto dim = nDim.get_dim(); dim > 0; --dim){
-      os << nDim.at(dim);
-      if (dim > 1){
-         os << " ";
-      }
-   }
-   os << "]";
-   return os;
-}
-
-std::ostream & operator<<(std::ostream & os, std::pair<unsigned int, NDim> const & linearNDim){
-   return os << "<" << linearNDim.first << ", " << linearNDim.second << ">";
-}
+#include "ndim.hpp"
+#include "ndim_layout.hpp"
+#include "fixed_ndim.hpp"
+#include "ndim_batch.hpp"
+#include "ndim_iterator.hpp"
+#include "ndim_views.hpp"
+#include "ndim_parallel.hpp"
+#include "space_filling_curve.hpp"
+#include "mapping_test_suite.hpp"
 
 void print_mapping(std::vector<std::pair<NDim, unsigned int>> const & mapping){
    for(auto [multi_index, linear_index] : mapping){
@@ -101,10 +42,11 @@ void print_mapping(std::vector<std::pair<unsigned int, NDim>> const & mapping){
 // where n is the highest dimensions and 1 the smallest
 // source: https://stackoverflow.com/questions/29142417/4d-position-from-1d-index
 
-unsigned int get_linear_index_impl(NDim const & nDposition, NDim const & nDdimsize, unsigned int const current_dim){
+template<typename TIndex>
+TIndex get_linear_index_impl(BasicNDim<TIndex> const & nDposition, BasicNDim<TIndex> const & nDdimsize, unsigned int const current_dim){
    if(current_dim > 1){
       // this is xn
-      unsigned int partial_index = nDposition.at(current_dim);
+      TIndex partial_index = nDposition.at(current_dim);
       // this part calculate the term: ( D{n-1} * ... * D1  )
       for(unsigned int d = current_dim - 1; // starts with a dimension smaller than the current
           d > 0; // abort, if we are in the sequential part
@@ -124,74 +66,25 @@ unsigned int get_linear_index_impl(NDim const & nDposition, NDim const & nDdimsi
 /// @param nDposition Position in the in the n dimensional index.
 /// @param nDdimsize Size of each dimension.
 /// @return Linear index.
-unsigned int get_linear_index(NDim const & nDposition, NDim const & nDdimsize){
+template<typename TIndex>
+TIndex get_linear_index(BasicNDim<TIndex> const & nDposition, BasicNDim<TIndex> const & nDdimsize){
    return get_linear_index_impl(nDposition, nDdimsize, nDdimsize.get_dim());
 }
 
-/// @brief Helper function to iterate over each possible position in a multi dimensional index and maps the 
-///        position to a linear index.
-/// @param nDposition Position in multi dimensional index.
-/// @param nDdimsize Dimension sizes of the multi dimensional index.
-/// @param mappingNDto1D Stores mappings from multi dimensional coordinate to linear coordinate.
-/// @param access_counter Counts, how many indices was calculated. Only for verification.
-/// @param current_dim The current dimension.
-void iterate_over_dim_impl(NDim & nDposition,
-                 NDim const & nDdimsize,   
-                 std::vector<std::pair<NDim, unsigned int>> & mappingNDto1D, 
-                 unsigned int & access_counter,
-                 unsigned int const current_dim){
-   if(current_dim > 0){
-      
-      for(unsigned int dim_index = 0; dim_index < nDdimsize.at(current_dim); ++dim_index){
-         nDposition.at(current_dim) = dim_index;
-         iterate_over_dim_impl(nDposition, nDdimsize, mappingNDto1D, access_counter, current_dim-1);
-      }
-   } else {
-      mappingNDto1D[access_counter] = std::pair<NDim, unsigned int>(nDposition, get_linear_index(nDposition, nDdimsize));
-      ++access_counter;
-   }
-}
-
-void iterate_over_dim_impl(NDim & nDposition,
-                 NDim const & nDdimsize,
-                 std::vector<std::pair<NDim, unsigned int>> & mappingNDto1D, 
-                 unsigned int & access_counter){
-   iterate_over_dim_impl(nDposition, nDdimsize, mappingNDto1D, access_counter, nDposition.get_dim());
-}
-
 /// @brief Iterate over each possible position in a multi dimensional index and maps the 
 ///        position to a linear index.
 /// @param nDdimsize Dimension sizes of the multi dimensional index.
 /// @return Mapping mappings from multi dimensional coordinate to linear coordinate.
 std::vector<std::pair<NDim, unsigned int>> to1D(NDim nDdimsize){
-   assert(nDdimsize.get_dim() > 0 && "Zero dimensions are not allowed.");
-
-   unsigned int total_elements = 1;
-
    std::cout << "dimensions: ";
    for(unsigned int dim = nDdimsize.get_dim(); dim > 0; --dim){
-      total_elements *= nDdimsize.at(dim);
       std::cout << nDdimsize.at(dim) << ", ";
    }
    std::cout << std::endl;
    
-   std::cout << "total elements: " << total_elements << std::endl;
-
-   // use external counter to count how many index calculations happened. In the end, needs to be equal to total_elements 
-   unsigned int access_counter = 0;
-   NDim nDposition(nDdimsize.get_dim(), 0);
-   std::vector<std::pair<NDim, unsigned int>> mappingNDto1D(total_elements);
-   
-   iterate_over_dim_impl(nDposition, nDdimsize, mappingNDto1D, access_counter);
+   std::cout << "total elements: " << nDdimsize.get_total_elements() << std::endl;
 
-   if (access_counter != total_elements){ 
-      std::stringstream ss;
-      ss << "Does not create enough linear index positions\n";
-      ss << "access_counter: " << access_counter << "\n";
-      ss << "total_elements: " << total_elements << "\n";
-      throw std::runtime_error(ss.str());
-   }
-   return mappingNDto1D;
+   return to_vector(views::to1D(nDdimsize));
 }
 
 // ################################################################################################
@@ -236,8 +129,9 @@ void get_multi_index_impl(unsigned int linear_index, NDim const & nDdimsize, NDi
       // ### dividend part
       unsigned int part_dividend = nDposition.at(current_dim-1);
       // the special case for x2 is here handled, because dim is smaller than 1, so no multiplication will happen
+      // x{n-1} is multiplied with D{n-2} * ... * D1
       for(unsigned int dim = current_dim -1; dim > 1; --dim){
-         part_dividend *= nDdimsize.at(dim);
+         part_dividend *= nDdimsize.at(dim - 1);
       }
       dividend -= part_dividend;
       // ### dividend part
@@ -262,19 +156,24 @@ NDim get_multi_index(unsigned int linear_index, NDim const & nDdimsize){
    return nDposition;
 }
 
+namespace views {
+
+   /// @brief Lazy version of toND(). Maps each linear index to a multi dimensional index with get_multi_index().
+   /// @param nDdimsize Dimension sizes of the multi dimensional index.
+   /// @return View of pairs of linear and multi dimensional coordinate.
+   inline auto toND(NDim nDdimsize){
+      return linear_to_multi(std::move(nDdimsize), [](unsigned int const i, NDim const & dimsize){
+         return get_multi_index(i, dimsize);
+      });
+   }
+
+} // namespace views
+
 /// @brief Maps all possible linear index to multi dimensional indices in the index room of nDdimsize.
 /// @param nDdimsize Dimension sizes of the multi dimensional index.
 /// @return Mapping mappings from linear coordinate to multi dimensional coordinate.
 std::vector<std::pair<unsigned int, NDim>> toND(NDim nDdimsize){
-   unsigned int total_elements = nDdimsize.get_total_elements();
-
-   std::vector<std::pair<unsigned int, NDim>> mapping(total_elements);
-
-   for(unsigned int i = 0; i < total_elements; ++i){
-      mapping[i] = std::pair(i, get_multi_index(i, nDdimsize));
-   }
-   
-   return mapping;
+   return to_vector(views::toND(std::move(nDdimsize)));
 }
 
 // The formula to calculate the multi dimensional index from a linear index using integer division is:
@@ -322,19 +221,761 @@ NDim get_multi_index_v2(unsigned int linear_index, NDim const & nDdimsize){
    return nDposition;
 }
 
+namespace views {
+
+   /// @brief Lazy version of toND_v2(). Maps each linear index to a multi dimensional index with
+   ///        get_multi_index_v2().
+   /// @param nDdimsize Dimension sizes of the multi dimensional index.
+   /// @return View of pairs of linear and multi dimensional coordinate.
+   inline auto toND_v2(NDim nDdimsize){
+      return linear_to_multi(std::move(nDdimsize), [](unsigned int const i, NDim const & dimsize){
+         return get_multi_index_v2(i, dimsize);
+      });
+   }
+
+} // namespace views
+
 /// @brief Maps all possible linear index to multi dimensional indices in the index room of nDdimsize.
 /// @param nDdimsize Dimension sizes of the multi dimensional index.
 /// @return Mapping mappings from linear coordinate to multi dimensional coordinate.
 std::vector<std::pair<unsigned int, NDim>> toND_v2(NDim nDdimsize){
-   unsigned int total_elements = nDdimsize.get_total_elements();
+   return to_vector(views::toND_v2(std::move(nDdimsize)));
+}
 
-   std::vector<std::pair<unsigned int, NDim>> mapping(total_elements);
+// ################################################################################################
+// ### precalculated layout
+// ################################################################################################
 
+/// @brief Compares the results of NDimLayout with get_linear_index() and get_multi_index_v2() for each element
+///        of the index room.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @return True, if all results are equal.
+bool check_layout(NDim const & nDdimsize){
+   NDimLayout const layout(nDdimsize);
+   unsigned int const total_elements = layout.get_total_elements();
+   bool equal = (total_elements == nDdimsize.get_total_elements());
+
+   std::vector<unsigned int> linear_indices(total_elements);
+   std::vector<NDim> nDpositions(total_elements, NDim(nDdimsize.get_dim(), 0));
    for(unsigned int i = 0; i < total_elements; ++i){
-      mapping[i] = std::pair(i, get_multi_index_v2(i, nDdimsize));
+      linear_indices[i] = i;
    }
-   
-   return mapping;
+   layout.to_multi(linear_indices, nDpositions);
+
+   std::vector<unsigned int> linear_indices_back(total_elements);
+   layout.to_linear(nDpositions, linear_indices_back);
+
+   for(unsigned int i = 0; i < total_elements; ++i){
+      NDim const expected = get_multi_index_v2(i, nDdimsize);
+      if(layout.to_multi(i) != expected || nDpositions[i] != expected){
+         equal = false;
+         std::cout << "layout.to_multi(" << i << ") != " << expected << std::endl;
+      }
+      if(layout.to_linear(expected) != get_linear_index(expected, nDdimsize) || linear_indices_back[i] != i){
+         equal = false;
+         std::cout << "layout.to_linear(" << expected << ") != " << i << std::endl;
+      }
+   }
+
+   std::cout << "NDimLayout " << nDdimsize << (equal ? " matches " : " does not match ") << "the runtime implementation" << std::endl;
+   return equal;
+}
+
+/// @brief Compares FastDivider with the hardware division for many divisors and dividends, including the corner
+///        cases 0, 1 and the largest unsigned int.
+/// @return True, if all results are equal.
+bool check_fast_divider(){
+   std::vector<unsigned int> divisors;
+   for(unsigned int d = 1; d <= 1024; ++d){
+      divisors.push_back(d);
+   }
+   for(unsigned int const d : {65535u, 65536u, 65537u, 1000003u, 2147483647u, 2147483648u, 4294967294u, 4294967295u}){
+      divisors.push_back(d);
+   }
+
+   // linear congruential generator with fixed seed, that the check is reproducible
+   unsigned int random = 42;
+   bool equal = true;
+   for(unsigned int const d : divisors){
+      FastDivider const divider(d);
+      std::vector<unsigned int> dividends{0u, 1u, d - 1, d, d + 1, 2 * d - 1, 2 * d, 4294967294u, 4294967295u};
+      for(unsigned int i = 0; i < 1000; ++i){
+         random = random * 1664525u + 1013904223u;
+         dividends.push_back(random);
+      }
+
+      for(unsigned int const n : dividends){
+         if(divider.divide(n) != n / d){
+            equal = false;
+            std::cout << "FastDivider: " << n << " / " << d << " = " << divider.divide(n) << " != " << n / d << std::endl;
+         }
+      }
+   }
+
+   std::cout << "FastDivider " << (equal ? "matches " : "does not match ") << "the hardware division" << std::endl;
+   return equal;
+}
+
+/// @brief Compares NDimLayout with DivisionMode::fast against get_multi_index() and get_multi_index_v2() for each
+///        index room with 1 to max_dim dimensions and 1 to max_size elements in each dimension.
+/// @param max_dim Maximum number of dimensions.
+/// @param max_size Maximum size of a dimension.
+/// @return True, if all results are equal.
+bool check_fast_division_layouts(unsigned int const max_dim, unsigned int const max_size){
+   bool equal = true;
+   unsigned int number_of_layouts = 0;
+
+   for(unsigned int dim = 1; dim <= max_dim; ++dim){
+      // iterate over all possible dimension sizes like an odometer
+      NDim nDdimsize(dim, 1);
+      bool finished = false;
+      while(!finished){
+         NDimLayout const layout(nDdimsize, DivisionMode::fast);
+         NDim nDposition(dim, 0);
+         for(unsigned int i = 0; i < layout.get_total_elements(); ++i){
+            layout.to_multi(i, nDposition);
+            if(nDposition != get_multi_index(i, nDdimsize) || nDposition != get_multi_index_v2(i, nDdimsize)){
+               equal = false;
+               std::cout << "fast division layout " << nDdimsize << ": to_multi(" << i << ") = " << nDposition
+                         << " != " << get_multi_index_v2(i, nDdimsize) << std::endl;
+            }
+         }
+         ++number_of_layouts;
+
+         finished = true;
+         for(unsigned int d = 1; d <= dim; ++d){
+            if(nDdimsize.at(d) < max_size){
+               ++nDdimsize.at(d);
+               finished = false;
+               break;
+            }
+            nDdimsize.at(d) = 1;
+         }
+      }
+   }
+
+   std::cout << "NDimLayout with fast division " << (equal ? "matches " : "does not match ")
+             << "get_multi_index() and get_multi_index_v2() for " << number_of_layouts << " layouts" << std::endl;
+   return equal;
+}
+
+// ################################################################################################
+// ### SIMD batch
+// ################################################################################################
+
+/// @brief Return all instruction sets, which are supported by the CPU.
+std::vector<SimdLevel> get_supported_simd_levels(){
+   std::vector<SimdLevel> levels{SimdLevel::scalar};
+   SimdLevel const best = detect_simd_level();
+   if(best == SimdLevel::avx2 || best == SimdLevel::avx512){
+      levels.push_back(SimdLevel::avx2);
+   }
+   if(best == SimdLevel::avx512){
+      levels.push_back(SimdLevel::avx512);
+   }
+   return levels;
+}
+
+/// @brief Compares toND_v2_batch() with toND_v2() for each supported instruction set.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @return True, if all results are equal.
+bool check_batch(NDim const & nDdimsize){
+   auto const expected = toND_v2(nDdimsize);
+
+   bool equal = true;
+   for(SimdLevel const level : get_supported_simd_levels()){
+      NDimBatch const batch = toND_v2_batch(nDdimsize, level);
+      bool equal_level = (batch.size() == expected.size());
+      for(std::size_t i = 0; equal_level && i < batch.size(); ++i){
+         if(batch.get(i) != expected[i].second){
+            equal_level = false;
+            std::cout << get_simd_level_name(level) << ": toND_v2_batch()[" << i << "] = " << batch.get(i)
+                      << " != " << expected[i].second << std::endl;
+         }
+      }
+      std::cout << "toND_v2_batch " << nDdimsize << " with " << get_simd_level_name(level)
+                << (equal_level ? " matches " : " does not match ") << "toND_v2" << std::endl;
+      equal &= equal_level;
+   }
+   return equal;
+}
+
+/// @brief Compares to_multi_batch() with NDimLayout::to_multi() for random linear indices of an index room, which
+///        uses nearly the complete range of unsigned int.
+/// @return True, if all results are equal.
+bool check_batch_large_index(){
+   NDimLayout const layout(NDim{1000, 999, 4297});
+
+   // linear congruential generator with fixed seed, that the check is reproducible
+   unsigned int random = 42;
+   std::vector<unsigned int> linear_indices(4099);
+   for(unsigned int & linear_index : linear_indices){
+      random = random * 1664525u + 1013904223u;
+      linear_index = random % layout.get_total_elements();
+   }
+   linear_indices.back() = layout.get_total_elements() - 1;
+
+   bool equal = true;
+   for(SimdLevel const level : get_supported_simd_levels()){
+      NDimBatch batch(layout.get_dim(), linear_indices.size());
+      to_multi_batch(layout, linear_indices, batch, level);
+      for(std::size_t i = 0; i < linear_indices.size(); ++i){
+         if(batch.get(i) != layout.to_multi(linear_indices[i])){
+            equal = false;
+            std::cout << get_simd_level_name(level) << ": to_multi_batch(" << linear_indices[i] << ") = "
+                      << batch.get(i) << " != " << layout.to_multi(linear_indices[i]) << std::endl;
+         }
+      }
+   }
+   std::cout << "to_multi_batch " << layout.get_dimsize() << (equal ? " matches " : " does not match ")
+             << "NDimLayout::to_multi()" << std::endl;
+   return equal;
+}
+
+/// @brief Measure the runtime of toND_v2() and toND_v2_batch().
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+void benchmark_batch(NDim const & nDdimsize){
+   auto const measure = [](auto && func){
+      auto const start = std::chrono::steady_clock::now();
+      func();
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+   };
+
+   std::cout << "runtime " << nDdimsize << " (" << nDdimsize.get_total_elements() << " elements)" << std::endl;
+   std::cout << "  toND_v2: " << measure([&](){ return toND_v2(nDdimsize); }) << " ms" << std::endl;
+   for(SimdLevel const level : get_supported_simd_levels()){
+      std::cout << "  toND_v2_batch " << get_simd_level_name(level) << ": "
+                << measure([&](){ return toND_v2_batch(nDdimsize, level); }) << " ms" << std::endl;
+   }
+}
+
+// ################################################################################################
+// ### odometer iterator
+// ################################################################################################
+
+/// @brief Compares the positions of NDimRange with toND_v2() and get_linear_index(). Checks the increment and the
+///        jumps of operator+=.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @return True, if all results are equal.
+bool check_iterator(NDim const & nDdimsize){
+   auto const expected = toND_v2(nDdimsize);
+   NDimRange const range(nDdimsize);
+
+   bool equal = (range.size() == expected.size());
+   unsigned int counter = 0;
+   for(auto [linear_index, nDposition] : range){
+      if(linear_index != counter || nDposition != expected[counter].second || get_linear_index(nDposition, nDdimsize) != linear_index){
+         equal = false;
+         std::cout << "NDimRange: <" << linear_index << ", " << nDposition << "> != " << expected[counter] << std::endl;
+      }
+      ++counter;
+   }
+   equal &= (counter == expected.size());
+
+   for(unsigned int const step : {2u, 3u, 7u}){
+      for(auto it = range.begin(); it != range.end(); ){
+         if(it.get_multi_index() != expected[it.get_linear_index()].second){
+            equal = false;
+            std::cout << "NDimRange += " << step << ": " << it.get_multi_index() << " != " << expected[it.get_linear_index()] << std::endl;
+         }
+         if(range.end() - it < static_cast<std::ptrdiff_t>(step)){
+            break;
+         }
+         it += step;
+      }
+   }
+
+   // a jump to the end has the same multi dimensional index like the increment of the last element
+   auto jumped_end = range.begin();
+   jumped_end += static_cast<std::ptrdiff_t>(range.size());
+   auto incremented_end = range.begin() + static_cast<std::ptrdiff_t>(range.size() - 1);
+   ++incremented_end;
+   equal &= jumped_end == range.end() && jumped_end.get_multi_index() == incremented_end.get_multi_index();
+
+   // decrement from the end and random access
+   counter = static_cast<unsigned int>(expected.size());
+   for(auto it = range.end(); it != range.begin(); ){
+      --it;
+      --counter;
+      if(it.get_multi_index() != expected[counter].second || range.begin()[counter].second != expected[counter].second){
+         equal = false;
+         std::cout << "NDimRange --: " << it.get_multi_index() << " != " << expected[counter] << std::endl;
+      }
+   }
+   equal &= range.begin() < range.end() && (range.end() - 1) >= range.begin() && (range.end() -= static_cast<std::ptrdiff_t>(range.size())) == range.begin();
+
+   std::cout << "NDimRange " << nDdimsize << (equal ? " matches " : " does not match ") << "toND_v2" << std::endl;
+   return equal;
+}
+
+// ################################################################################################
+// ### lazy view composition
+// ################################################################################################
+
+/// @brief Combines the lazy views with std::views::filter, std::views::take and views::chunk and compares the
+///        results with the materialized mappings.
+/// @return True, if all results are equal.
+bool check_views(){
+   NDim const nDdimsize{2, 4, 3, 5};
+   auto const expected = toND_v2(nDdimsize);
+   bool equal = true;
+
+   // all positions, where the smallest dimension is 0
+   auto first_column = views::toND_v2(nDdimsize)
+                       | std::views::filter([](auto const & mapping){ return mapping.second.at(1) == 0; });
+   unsigned int counter = 0;
+   for(auto const & [linear_index, nDposition] : first_column){
+      if(linear_index != counter * nDdimsize.at(1) || nDposition != expected[linear_index].second){
+         equal = false;
+         std::cout << "filter: <" << linear_index << ", " << nDposition << ">" << std::endl;
+      }
+      ++counter;
+   }
+   equal &= (counter == nDdimsize.get_total_elements() / nDdimsize.at(1));
+
+   // only the first 7 elements are calculated
+   auto const first_elements = to_vector(views::toND(nDdimsize) | std::views::take(7));
+   equal &= first_elements.size() == 7 && std::equal(first_elements.begin(), first_elements.end(), expected.begin());
+
+   // views::to1D is the inverse mapping of views::toND_v2 and generated by the odometer, therefore it can check the
+   // formula of get_linear_index()
+   for(auto const & [nDposition, linear_index] : views::to1D(nDdimsize)){
+      if(expected[linear_index].second != nDposition || get_linear_index(nDposition, nDdimsize) != linear_index){
+         equal = false;
+         std::cout << "to1D: <" << nDposition << ", " << linear_index << ">" << std::endl;
+      }
+   }
+
+   // chunks of 16 elements, e.g. one chunk per thread
+   unsigned int number_of_chunks = 0;
+   unsigned int chunk_begin = 0;
+   for(auto const chunk : views::chunk(views::toND_v2(nDdimsize), 16)){
+      std::cout << "chunk " << number_of_chunks << ":";
+      for(auto const & mapping : chunk){
+         if(mapping != expected[chunk_begin]){
+            equal = false;
+         }
+         ++chunk_begin;
+      }
+      std::cout << " " << (*chunk.begin()).first << " ... " << chunk_begin - 1 << std::endl;
+      ++number_of_chunks;
+   }
+   equal &= (chunk_begin == expected.size()) && (number_of_chunks == (expected.size() + 15) / 16);
+
+   std::cout << "lazy views " << (equal ? "match " : "do not match ") << "the materialized mappings" << std::endl;
+   return equal;
+}
+
+// ################################################################################################
+// ### parallel mapping
+// ################################################################################################
+
+/// @brief Compares the parallel versions of toND_v2() and to1D() with the serial versions for different numbers of
+///        threads and chunk sizes.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @return True, if all results are equal.
+bool check_parallel(NDim const & nDdimsize){
+   auto const expected_toND = toND_v2(nDdimsize);
+   auto const expected_to1D = to1D(nDdimsize);
+
+   bool equal = true;
+   for(unsigned int const number_of_threads : {1u, 2u, 3u, 8u}){
+      for(unsigned int const chunk_size : {1u, 7u, default_chunk_size}){
+         if(toND_v2_parallel(nDdimsize, number_of_threads, chunk_size) != expected_toND){
+            equal = false;
+            std::cout << "toND_v2_parallel(" << nDdimsize << ", " << number_of_threads << ", " << chunk_size << ") is wrong" << std::endl;
+         }
+         if(to1D_parallel(nDdimsize, number_of_threads, chunk_size) != expected_to1D){
+            equal = false;
+            std::cout << "to1D_parallel(" << nDdimsize << ", " << number_of_threads << ", " << chunk_size << ") is wrong" << std::endl;
+         }
+      }
+   }
+   equal &= (toND_v2_parallel(std::execution::par, nDdimsize, 7) == expected_toND);
+   equal &= (to1D_parallel(std::execution::par, nDdimsize, 7) == expected_to1D);
+
+   // the chunk arithmetic does not overflow near the maximum of the index type
+   unsigned int constexpr max_index = std::numeric_limits<unsigned int>::max();
+   equal &= detail::get_number_of_chunks(max_index, default_chunk_size) == max_index / default_chunk_size + 1;
+   equal &= detail::get_chunk_end(max_index - 10, default_chunk_size, max_index) == max_index;
+
+   std::cout << "parallel mapping " << nDdimsize << (equal ? " matches " : " does not match ") << "the serial mapping" << std::endl;
+   return equal;
+}
+
+/// @brief Measure the runtime of toND_v2_parallel() with 1 to 64 threads and compare it with toND_v2().
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @return True, if all results are equal to the serial result.
+bool benchmark_parallel(NDim const & nDdimsize){
+   using clock = std::chrono::steady_clock;
+   std::cout << "runtime " << nDdimsize << " (" << nDdimsize.get_total_elements() << " elements, "
+             << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+
+   auto start = clock::now();
+   auto const expected = toND_v2(nDdimsize);
+   double const serial_time = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+   std::cout << "  toND_v2: " << serial_time << " ms" << std::endl;
+
+   bool equal = true;
+   for(unsigned int number_of_threads = 1; number_of_threads <= 64; number_of_threads *= 2){
+      start = clock::now();
+      auto const mapping = toND_v2_parallel(nDdimsize, number_of_threads);
+      double const time = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+      equal &= (mapping == expected);
+      std::cout << "  toND_v2_parallel " << number_of_threads << " threads: " << time << " ms (speedup "
+                << serial_time / time << ")" << std::endl;
+   }
+
+   start = clock::now();
+   auto const mapping = toND_v2_parallel(std::execution::par, nDdimsize);
+   double const time = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+   equal &= (mapping == expected);
+   std::cout << "  toND_v2_parallel std::execution::par: " << time << " ms (speedup " << serial_time / time << ")" << std::endl;
+
+   std::cout << "parallel mapping is " << (equal ? "" : "not ") << "bit identical" << std::endl;
+   return equal;
+}
+
+// ################################################################################################
+// ### 64 bit index and overflow check
+// ################################################################################################
+
+/// @brief Checks that OverflowCheck::checked detects index rooms, which are too large for the index type.
+/// @return True, if the overflow is detected only for the too large index rooms.
+bool check_overflow_detection(){
+   bool correct = true;
+
+   auto const throws_overflow = [](auto const & nDdimsize){
+      using layout_type = BasicNDimLayout<typename std::decay_t<decltype(nDdimsize)>::index_type>;
+      try {
+         layout_type const layout(nDdimsize, DivisionMode::hardware, OverflowCheck::checked);
+      } catch (std::overflow_error const & e){
+         std::cout << "expected overflow: " << e.what() << std::endl;
+         return true;
+      }
+      return false;
+   };
+
+   // 2^32 elements
+   correct &= throws_overflow(NDim{65536, 65536});
+   correct &= throws_overflow(NDim{2, 3, 65536, 65536});
+   // 2^32 - 1 elements
+   correct &= !throws_overflow(NDim{65535, 65537});
+   correct &= !throws_overflow(BasicNDim<std::uint64_t>{65536, 65536});
+   correct &= throws_overflow(BasicNDim<std::uint64_t>{65536, 65536, 65536, 65536});
+
+   std::cout << "OverflowCheck::checked " << (correct ? "detects " : "does not detect ") << "all overflows" << std::endl;
+   return correct;
+}
+
+/// @brief Compares FastDivider64 with the hardware division and the 64 bit layout with the runtime implementation
+///        for random linear indices of an index room with more than 2^32 elements.
+/// @return True, if all results are equal.
+bool check_64bit_layout(){
+   using index_type = std::uint64_t;
+   BasicNDim<index_type> const nDdimsize{3, 65536, 65536, 7};
+   BasicNDimLayout<index_type> const layout(nDdimsize, DivisionMode::hardware, OverflowCheck::checked);
+   BasicNDimLayout<index_type> const layout_fast(nDdimsize, DivisionMode::fast, OverflowCheck::checked);
+
+   // linear congruential generator with fixed seed, that the check is reproducible
+   index_type random = 42;
+   auto const next_random = [&random](){
+      random = random * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+      return random;
+   };
+
+   bool equal = true;
+   for(index_type const d : {index_type{3}, index_type{7}, layout.get_step_length(2), layout.get_step_length(3),
+                             layout.get_step_length(4), UINT64_C(0xFFFFFFFFFFFFFFFF), UINT64_C(0x8000000000000001)}){
+      FastDivider64 const divider(d);
+      for(unsigned int i = 0; i < 1000; ++i){
+         index_type const n = next_random();
+         if(divider.divide(n) != n / d){
+            equal = false;
+            std::cout << "FastDivider64: " << n << " / " << d << " = " << divider.divide(n) << " != " << n / d << std::endl;
+         }
+      }
+   }
+
+   BasicNDim<index_type> nDposition(nDdimsize.get_dim(), 0);
+   BasicNDim<index_type> nDposition_fast(nDdimsize.get_dim(), 0);
+   for(unsigned int i = 0; i < 10000; ++i){
+      index_type const linear_index = (i == 0) ? layout.get_total_elements() - 1 : next_random() % layout.get_total_elements();
+      layout.to_multi(linear_index, nDposition);
+      layout_fast.to_multi(linear_index, nDposition_fast);
+      if(nDposition != nDposition_fast || layout.to_linear(nDposition) != linear_index
+         || get_linear_index(nDposition, nDdimsize) != linear_index){
+         equal = false;
+         std::cout << "64 bit layout: " << linear_index << " -> " << nDposition << " / " << nDposition_fast << std::endl;
+      }
+   }
+
+   std::cout << "64 bit NDimLayout " << nDdimsize << " with " << layout.get_total_elements() << " elements"
+             << (equal ? " matches " : " does not match ") << "the runtime implementation" << std::endl;
+   return equal;
+}
+
+// ################################################################################################
+// ### compile time number of dimensions
+// ################################################################################################
+
+static_assert(get_linear_index(fixed::NDim{1, 2, 0, 3}, fixed::NDim{2, 4, 3, 5}) == 1 * 60 + 2 * 15 + 0 * 5 + 3);
+static_assert(get_multi_index(93, fixed::NDim{2, 4, 3, 5}) == fixed::NDim{1, 2, 0, 3});
+static_assert(get_multi_index_v2(93, fixed::NDim{2, 4, 3, 5}) == fixed::NDim{1, 2, 0, 3});
+static_assert(get_linear_index(fixed::NDim<2, std::uint64_t>{65536, 65535}, fixed::NDim<2, std::uint64_t>{65537, 65536}) == UINT64_C(4295032831));
+
+/// @brief Compares the results of the fixed::NDim overloads with the runtime implementation for each element of
+///        the index room.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @return True, if all results are equal.
+template<unsigned int Rank>
+bool check_fixed_rank(fixed::NDim<Rank> const & nDdimsize){
+   NDim runtime_dimsize(Rank, 0);
+   for(unsigned int dim = 1; dim <= Rank; ++dim){
+      runtime_dimsize.at(dim) = nDdimsize.at(dim);
+   }
+
+   auto const is_equal = [](fixed::NDim<Rank> const & fixed_index, NDim const & runtime_index){
+      for(unsigned int dim = 1; dim <= Rank; ++dim){
+         if(fixed_index.at(dim) != runtime_index.at(dim)){
+            return false;
+         }
+      }
+      return true;
+   };
+
+   bool equal = true;
+   for(unsigned int i = 0; i < nDdimsize.get_total_elements(); ++i){
+      auto const nDposition = get_multi_index(i, nDdimsize);
+      if(!is_equal(nDposition, get_multi_index(i, runtime_dimsize))){
+         equal = false;
+         std::cout << "fixed get_multi_index(" << i << ") != " << get_multi_index(i, runtime_dimsize) << std::endl;
+      }
+      if(!is_equal(get_multi_index_v2(i, nDdimsize), get_multi_index_v2(i, runtime_dimsize))){
+         equal = false;
+         std::cout << "fixed get_multi_index_v2(" << i << ") != " << get_multi_index_v2(i, runtime_dimsize) << std::endl;
+      }
+      if(get_linear_index(nDposition, nDdimsize) != i){
+         equal = false;
+         std::cout << "fixed get_linear_index(" << nDposition << ") != " << i << std::endl;
+      }
+   }
+
+   std::cout << "fixed::NDim " << nDdimsize << (equal ? " matches " : " does not match ") << "the runtime implementation" << std::endl;
+   return equal;
+}
+
+// ################################################################################################
+// ### shared test suite
+// ################################################################################################
+
+/// @brief Runs the mapping test suite, which is shared with compile.cpp, on the recursive functions and on
+///        NDimLayout.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @return True, if all implementations pass the test suite.
+bool check_runtime_mapping(NDim const & nDdimsize){
+   auto const to_linear = [&](NDim const & nDposition){ return get_linear_index(nDposition, nDdimsize); };
+   bool equal = mapping_test_suite::check_mapping("get_multi_index", nDdimsize, to_linear,
+      [&](unsigned int const linear_index){ return get_multi_index(linear_index, nDdimsize); });
+   equal &= mapping_test_suite::check_mapping("get_multi_index_v2", nDdimsize, to_linear,
+      [&](unsigned int const linear_index){ return get_multi_index_v2(linear_index, nDdimsize); });
+
+   for(DivisionMode const mode : {DivisionMode::hardware, DivisionMode::fast}){
+      NDimLayout const layout(nDdimsize, mode);
+      equal &= mapping_test_suite::check_mapping(mode == DivisionMode::fast ? "NDimLayout fast" : "NDimLayout", nDdimsize,
+         [&](NDim const & nDposition){ return layout.to_linear(nDposition); },
+         [&](unsigned int const linear_index){ return layout.to_multi(linear_index); });
+   }
+   return equal;
+}
+
+// ################################################################################################
+// ### space filling curves
+// ################################################################################################
+
+static_assert(sfc::morton::get_linear_index(fixed::NDim{1, 0}, fixed::NDim{4, 4}) == 2);
+static_assert(sfc::morton::get_linear_index(fixed::NDim{3, 2, 1}, fixed::NDim{4, 4, 4}) == 0b110'101);
+static_assert(sfc::morton::get_multi_index_v2(0b110'101, fixed::NDim{4, 4, 4}) == fixed::NDim{3, 2, 1});
+static_assert(sfc::hilbert::get_multi_index_v2(sfc::hilbert::get_linear_index(fixed::NDim{5, 2}, fixed::NDim{8, 8}), fixed::NDim{8, 8}) == fixed::NDim{5, 2});
+static_assert(sfc::get_curve_size(fixed::NDim{3, 8, 5}) == 512);
+
+/// @brief Checks that the Morton and the Hilbert mapping are bijective for the index room and that two consecutive
+///        positions of the Hilbert curve are direct neighbors.
+/// @param nDdimsize Dimension sizes of the multi dimensional index.
+/// @return True, if all checks are passed.
+template<unsigned int Rank>
+bool check_space_filling_curve(fixed::NDim<Rank> const & nDdimsize){
+   unsigned int const curve_size = sfc::get_curve_size(nDdimsize);
+
+   auto const is_inside = [&](fixed::NDim<Rank> const & nDposition){
+      for(unsigned int dim = 1; dim <= Rank; ++dim){
+         if(nDposition.at(dim) >= nDdimsize.at(dim)){
+            return false;
+         }
+      }
+      return true;
+   };
+
+   auto const check_curve = [&](char const * name, auto const & to_linear, auto const & to_multi){
+      bool equal = true;
+      // each position of the index room needs to be reached exactly once
+      std::vector<bool> visited(nDdimsize.get_total_elements(), false);
+      for(unsigned int i = 0; i < curve_size; ++i){
+         fixed::NDim<Rank> const nDposition = to_multi(i);
+         if(to_linear(nDposition) != i){
+            equal = false;
+            std::cout << name << " get_linear_index(" << nDposition << ") != " << i << std::endl;
+         }
+         if(is_inside(nDposition)){
+            unsigned int const row_major_index = get_linear_index(nDposition, nDdimsize);
+            equal &= !visited[row_major_index];
+            visited[row_major_index] = true;
+         }
+      }
+      equal &= std::all_of(visited.begin(), visited.end(), [](bool v){ return v; });
+      std::cout << name << " curve " << nDdimsize << " is " << (equal ? "" : "not ") << "bijective" << std::endl;
+      return equal;
+   };
+
+   bool equal = check_curve("Morton",
+      [&](fixed::NDim<Rank> const & p){ return sfc::morton::get_linear_index(p, nDdimsize); },
+      [&](unsigned int i){ return sfc::morton::get_multi_index_v2(i, nDdimsize); });
+   equal &= check_curve("Hilbert",
+      [&](fixed::NDim<Rank> const & p){ return sfc::hilbert::get_linear_index(p, nDdimsize); },
+      [&](unsigned int i){ return sfc::hilbert::get_multi_index_v2(i, nDdimsize); });
+   sfc::MortonLayout<Rank> const morton_layout(nDdimsize);
+   sfc::HilbertLayout<Rank> const hilbert_layout(nDdimsize);
+   equal &= check_curve("MortonLayout",
+      [&](fixed::NDim<Rank> const & p){ return morton_layout.to_linear(p); },
+      [&](unsigned int i){ return morton_layout.to_multi(i); });
+   equal &= check_curve("HilbertLayout",
+      [&](fixed::NDim<Rank> const & p){ return hilbert_layout.to_linear(p); },
+      [&](unsigned int i){ return hilbert_layout.to_multi(i); });
+
+   // the BMI2 instructions and the portable loop need to give the same result
+   auto const masks = sfc::detail::interleave_masks<Rank, unsigned int>(sfc::get_bits_per_dim(nDdimsize));
+   for(unsigned int i = 0; i < curve_size && sfc::detail::has_bmi2(); ++i){
+      fixed::NDim<Rank> bmi2;
+      fixed::NDim<Rank> portable;
+      sfc::detail::deinterleave<Rank>(i, bmi2.data(), masks, true);
+      sfc::detail::deinterleave<Rank>(i, portable.data(), masks, false);
+      equal &= bmi2 == portable
+               && sfc::detail::interleave<Rank>(bmi2.data(), masks, true) == sfc::detail::interleave<Rank>(portable.data(), masks, false);
+   }
+
+   for(unsigned int i = 1; i < curve_size; ++i){
+      fixed::NDim<Rank> const previous = sfc::hilbert::get_multi_index_v2(i - 1, nDdimsize);
+      fixed::NDim<Rank> const current = sfc::hilbert::get_multi_index_v2(i, nDdimsize);
+      unsigned int distance = 0;
+      for(unsigned int dim = 1; dim <= Rank; ++dim){
+         distance += std::max(previous.at(dim), current.at(dim)) - std::min(previous.at(dim), current.at(dim));
+      }
+      if(distance != 1){
+         equal = false;
+         std::cout << "Hilbert curve jumps from " << previous << " to " << current << std::endl;
+      }
+   }
+   return equal;
+}
+
+/// @brief Simulates a set associative cache with LRU replacement to count the cache misses of a memory access
+///        pattern independent of the hardware and other processes.
+class CacheSimulator {
+   unsigned int m_ways;
+   unsigned int m_sets;
+   // tag of each cache line, sorted from most to least recently used within each set
+   std::vector<std::uint64_t> m_tags;
+   std::uint64_t m_misses = 0;
+
+public:
+   static constexpr unsigned int line_size = 64;
+
+   CacheSimulator(unsigned int const cache_size, unsigned int const ways)
+      : m_ways(ways), m_sets(cache_size / line_size / ways), m_tags(m_sets * ways, ~std::uint64_t{0}) {}
+
+   void access(std::uint64_t const address){
+      std::uint64_t const line = address / line_size;
+      auto const set = m_tags.begin() + (line % m_sets) * m_ways;
+      auto const hit = std::find(set, set + m_ways, line);
+      if(hit == set + m_ways){
+         ++m_misses;
+         std::rotate(set, set + m_ways - 1, set + m_ways);
+         *set = line;
+      } else {
+         std::rotate(set, hit, hit + 1);
+      }
+   }
+
+   std::uint64_t get_misses() const {
+      return m_misses;
+   }
+};
+
+/// @brief Applies a 7 point stencil on a 3D grid, which is stored in row-major, Morton and Hilbert order. Each
+///        element is visited in memory order and reads its 6 neighbors. Counts the cache misses of a simulated L1
+///        (32 KiB, 8 way) and L2 (256 KiB, 16 way) cache and measures the runtime including the index calculation.
+/// @param size Size of each dimension, needs to be a power of two.
+void benchmark_space_filling_curve(unsigned int const size){
+   fixed::NDim<3> const nDdimsize(size, size, size);
+   std::vector<float> const grid(sfc::get_curve_size(nDdimsize), 1.f);
+   std::cout << "stencil on " << nDdimsize << " grid (BMI2 " << (sfc::detail::has_bmi2() ? "supported" : "not supported") << ")" << std::endl;
+
+   auto const run = [&](char const * name, auto const & to_linear, auto const & to_multi){
+      CacheSimulator l1(32 * 1024, 8);
+      CacheSimulator l2(256 * 1024, 16);
+      auto const load = [&](unsigned int const index){
+         std::uint64_t const address = index * sizeof(float);
+         l1.access(address);
+         l2.access(address);
+      };
+
+      for(unsigned int i = 0; i < grid.size(); ++i){
+         fixed::NDim<3> const nDposition = to_multi(i);
+         load(i);
+         for(unsigned int dim = 1; dim <= 3; ++dim){
+            for(int offset : {-1, 1}){
+               fixed::NDim<3> neighbor = nDposition;
+               neighbor.at(dim) += offset;
+               if(neighbor.at(dim) < size){
+                  load(to_linear(neighbor));
+               }
+            }
+         }
+      }
+
+      auto const start = std::chrono::steady_clock::now();
+      float sum = 0.f;
+      for(unsigned int i = 0; i < grid.size(); ++i){
+         fixed::NDim<3> const nDposition = to_multi(i);
+         float value = 6.f * grid[i];
+         for(unsigned int dim = 1; dim <= 3; ++dim){
+            for(int offset : {-1, 1}){
+               fixed::NDim<3> neighbor = nDposition;
+               neighbor.at(dim) += offset;
+               if(neighbor.at(dim) < size){
+                  value -= grid[to_linear(neighbor)];
+               }
+            }
+         }
+         sum += value;
+      }
+      double const time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+      std::cout << "  " << name << ": L1 misses " << l1.get_misses() << ", L2 misses " << l2.get_misses()
+                << ", " << time << " ms (checksum " << sum << ")" << std::endl;
+   };
+
+   run("row-major",
+      [&](fixed::NDim<3> const & p){ return get_linear_index(p, nDdimsize); },
+      [&](unsigned int i){ return get_multi_index_v2(i, nDdimsize); });
+   sfc::MortonLayout<3> const morton_layout(nDdimsize);
+   sfc::HilbertLayout<3> const hilbert_layout(nDdimsize);
+   run("Morton   ",
+      [&](fixed::NDim<3> const & p){ return morton_layout.to_linear(p); },
+      [&](unsigned int i){ return morton_layout.to_multi(i); });
+   run("Hilbert  ",
+      [&](fixed::NDim<3> const & p){ return hilbert_layout.to_linear(p); },
+      [&](unsigned int i){ return hilbert_layout.to_multi(i); });
 }
 
 int main(int argc, char **argv){
@@ -381,5 +1022,60 @@ int main(int argc, char **argv){
       std::cout << "linToN_1Dto4D and linToN_1Dto4Dv2 are not equal" << std::endl;
    }
 
-   return 0;
+   std::cout << std::endl;
+   for(NDim const & nDdimsize : {NDim{7}, NDim{2, 3}, NDim{2, 3, 5}, NDim{2, 4, 3, 5}, NDim{3, 1, 4, 2, 5}}){
+      equal &= check_layout(nDdimsize);
+   }
+
+   std::cout << std::endl;
+   equal &= check_fast_divider();
+   equal &= check_fast_division_layouts(4, 5);
+
+   std::cout << std::endl;
+   for(NDim const & nDdimsize : {NDim{7}, NDim{2, 3}, NDim{2, 3, 5}, NDim{2, 4, 3, 5}, NDim{3, 1, 4, 2, 5}, NDim{3, 7, 1, 5, 11}, NDim{3, 0, 2}}){
+      equal &= check_batch(nDdimsize);
+   }
+   equal &= check_batch_large_index();
+   benchmark_batch(NDim{8, 16, 16, 16, 16});
+
+   std::cout << std::endl;
+   for(NDim const & nDdimsize : {NDim{7}, NDim{2, 3}, NDim{2, 3, 5}, NDim{2, 4, 3, 5}, NDim{3, 1, 4, 2, 5}}){
+      equal &= check_iterator(nDdimsize);
+   }
+
+   std::cout << std::endl;
+   equal &= check_views();
+
+   std::cout << std::endl;
+   for(NDim const & nDdimsize : {NDim{7}, NDim{2, 3, 5}, NDim{2, 4, 3, 5}, NDim{3, 7, 1, 5, 11}}){
+      equal &= check_parallel(nDdimsize);
+   }
+   equal &= benchmark_parallel(NDim{4, 16, 16, 16, 16});
+
+   std::cout << std::endl;
+   equal &= check_overflow_detection();
+   equal &= check_64bit_layout();
+
+   std::cout << std::endl;
+   equal &= check_fixed_rank(fixed::NDim{7});
+   equal &= check_fixed_rank(fixed::NDim{2, 3});
+   equal &= check_fixed_rank(fixed::NDim{2, 3, 5});
+   equal &= check_fixed_rank(fixed::NDim{2, 4, 3, 5});
+   equal &= check_fixed_rank(fixed::NDim{3, 1, 4, 2, 5});
+
+   std::cout << std::endl;
+   mapping_test_suite::for_each_shape([&](auto shape){
+      equal &= check_runtime_mapping(mapping_test_suite::to_ndim(shape));
+   });
+
+   std::cout << std::endl;
+   equal &= check_space_filling_curve(fixed::NDim{8, 8});
+   equal &= check_space_filling_curve(fixed::NDim{5, 3});
+   equal &= check_space_filling_curve(fixed::NDim{4, 4, 4});
+   equal &= check_space_filling_curve(fixed::NDim{3, 8, 5});
+   equal &= check_space_filling_curve(fixed::NDim{4, 4, 4, 4});
+   equal &= check_space_filling_curve(fixed::NDim{2, 3, 4, 5});
+   benchmark_space_filling_curve(64);
+
+   return equal ? 0 : 1;
 }
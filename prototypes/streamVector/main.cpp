@@ -1,37 +1,26 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
-#include <ostream>
-#include <vector>
-
-template<typename TData>
-class MyVector : public std::vector<TData> {
-public:
-   MyVector(std::initializer_list<TData> list) : std::vector<TData>(list) {}
-   MyVector(MyVector const & other) : std::vector<TData>(other) {}
-
-   MyVector<TData> merge(MyVector<TData> const & other) const {
-      MyVector<TData> merged(*this);
-      merged.reserve(merged.size() + other.size());
-      std::copy(other.begin(), other.end(), std::back_inserter(merged));
-      return merged;
-   }
-};
-
-template<typename TData>
-MyVector<TData> operator<<(MyVector<TData> const & v1, MyVector<TData> const & v2){
-   return v1.merge(v2);
-}
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
 
-template<typename T>
-std::ostream & operator<<(std::ostream & os, MyVector<T> const & vec){
-   os << "[";
-   for(auto i = 0; i < vec.size(); ++i){
-      os << vec[i];
-      if (i != vec.size() - 1){
-         os << ", ";
-      }
-   }
-   os << "]";
-   return os;
+#include "my_vector.hpp"
+#include "pipeline.hpp"
+#include "pipelined.hpp"
+#include "stream.hpp"
+
+/// @brief Measure the runtime of func in milliseconds.
+template<typename TFunc>
+double measure(TFunc && func){
+   auto const start = std::chrono::steady_clock::now();
+   func();
+   return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 }
 
 int main(int argc, char **argv){
@@ -42,7 +31,7 @@ int main(int argc, char **argv){
    std::cout << "v1.merge(v2.merge(v3)): " << v1.merge(v2.merge(v3)) << std::endl;
    std::cout << "v1 << v2 << v3: " << v1<< v2 << v3 << std::endl;
    std::cout << "(v1 << v2 << v3): " << (v1<< v2 << v3) << std::endl;
-   auto v123 = v1<< v2 << v3;
+   MyVector<int> v123 = v1<< v2 << v3;
    std::cout << "v123: " << v123 << std::endl;
 
    std::cout << std::endl;
@@ -50,8 +39,217 @@ int main(int argc, char **argv){
    std::cout << "v3.merge(v1.merge(v2)): " << v3.merge(v1.merge(v2)) << std::endl;
    std::cout << "v3 << v1 << v2: " << v3 << v1 << v2 << std::endl;
    std::cout << "(v3 << v1 << v2): " << (v3 << v1 << v2) << std::endl;
-   auto v312 = v1<< v2 << v3;
+   MyVector<int> v312 = v1<< v2 << v3;
    std::cout << "v312: " << v312 << std::endl;
 
-   return 0;
+   std::cout << std::endl;
+
+   // a temporary left operand is extended in place
+   std::cout << "(MyVector<int>{0} << v1 << v2): " << (MyVector<int>{0} << v1 << v2) << std::endl;
+   std::cout << "(v1 << MyVector<int>{0} << v2): " << (v1 << MyVector<int>{0} << v2) << std::endl;
+   std::cout << "(MyVector<int>{0} << MyVector<int>{1}): " << (MyVector<int>{0} << MyVector<int>{1}) << std::endl;
+   // the lazy concatenation is explicit: a temporary right operand is moved
+   // into the node and the result is allocated once
+   std::cout << "concat(v1, MyVector<int>{0}) << v2: " << (concat(v1, MyVector<int>{0}) << v2) << std::endl;
+
+   // `auto` holds a vector and not a node, which references v1 and v2
+   auto const v12 = v1 << v2;
+   static_assert(std::is_same_v<decltype(v12), MyVector<int> const>);
+   MyVector<int> self{1, 2};
+   self = std::move(self) << self;
+   std::cout << "self = std::move(self) << self: " << self << std::endl;
+
+   std::cout << std::endl;
+
+   // Merge many batches to a single vector. The copying merge copies the
+   // result of all previous batches for each batch (O(k^2) copies). The rvalue
+   // merge appends to the buffer of the result (O(k) copies).
+   constexpr int number_of_batches = 10000;
+   MyVector<int> const batch{1, 2, 3, 4, 5, 6, 7, 8};
+
+   auto const start_copy = std::chrono::steady_clock::now();
+   MyVector<int> merged_copy;
+   for(auto i = 0; i < number_of_batches; ++i){
+      merged_copy = merged_copy.merge(batch);
+   }
+   auto const time_copy = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_copy).count();
+
+   auto const start_move = std::chrono::steady_clock::now();
+   MyVector<int> merged_move;
+   for(auto i = 0; i < number_of_batches; ++i){
+      merged_move = std::move(merged_move) << batch;
+   }
+   auto const time_move = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_move).count();
+
+   std::cout << "merge " << number_of_batches << " batches with copies: " << time_copy << " ms" << std::endl;
+   std::cout << "merge " << number_of_batches << " batches with rvalues: " << time_move << " ms" << std::endl;
+
+   MyVector<int> const v123_lazy = concat(v1, v2) << v3;
+   bool check = merged_copy == merged_move && v123 == v1.merge(v2).merge(v3) && v123_lazy == v123 &&
+                v12 == v1.merge(v2) && self == MyVector<int>{1, 2, 1, 2};
+
+   std::cout << std::endl;
+
+   // The stages are only composed by operator|. The pipeline is executed
+   // by operator<< with the executor in a single pass without intermediate
+   // vectors.
+   auto const twice = [](int const v){ return 2 * v; };
+   auto const increment = [](int const v){ return v + 1; };
+   SequentialExecutor sequential;
+   ThreadPoolExecutor thread_pool;
+   SimdChunkedExecutor<> simd_chunked;
+
+   std::cout << "v1 | twice | increment << sequential: " << (v1 | twice | increment << sequential) << std::endl;
+   auto const lazy = v1 | twice | increment;
+   std::cout << "lazy << thread_pool: " << (lazy << thread_pool) << std::endl;
+   std::cout << "v1 | increment << simd_chunked: " << (v1 | increment << simd_chunked) << std::endl;
+
+   std::cout << std::endl;
+
+   // compare the fused pipeline with a chain of std::transform, where each
+   // stage writes a temporary vector
+   constexpr std::size_t pipeline_size = std::size_t{1} << 24;
+   MyVector<float> input(pipeline_size);
+   std::iota(input.begin(), input.end(), 0.f);
+   auto const scale = [](float const v){ return v * 0.5f; };
+   auto const shift = [](float const v){ return v + 3.f; };
+   auto const square = [](float const v){ return v * v; };
+
+   MyVector<float> expected(pipeline_size);
+   double const time_transform = measure([&]{
+      MyVector<float> tmp1(pipeline_size);
+      MyVector<float> tmp2(pipeline_size);
+      std::transform(input.begin(), input.end(), tmp1.begin(), scale);
+      std::transform(tmp1.begin(), tmp1.end(), tmp2.begin(), shift);
+      std::transform(tmp2.begin(), tmp2.end(), expected.begin(), square);
+   });
+   std::cout << "std::transform chain: " << time_transform << " ms" << std::endl;
+   std::cout << "thread pool executor uses " << thread_pool.number_of_threads() << " threads" << std::endl;
+
+   auto const check_pipeline = [&](char const * name, auto & executor){
+      MyVector<float> output;
+      double const time = measure([&]{ output = input | scale | shift | square << executor; });
+      std::cout << "pipeline with " << name << ": " << time << " ms" << std::endl;
+      return output == expected;
+   };
+   check &= check_pipeline("sequential executor", sequential);
+   check &= check_pipeline("thread pool executor", thread_pool);
+   check &= check_pipeline("SIMD chunked executor", simd_chunked);
+
+   // An exception of a stage is rethrown on the calling thread, after all
+   // threads of the pool finished. Afterwards, the pool is still usable.
+   ThreadPoolExecutor throwing_pool(4);
+   auto const throw_upper_half = [](float const v){
+      if(v >= static_cast<float>(pipeline_size / 2)){
+         throw std::runtime_error("stage failed");
+      }
+      return v;
+   };
+   bool rethrown = false;
+   try{
+      MyVector<float> const output = input | throw_upper_half << throwing_pool;
+   }
+   catch(std::runtime_error const &){
+      rethrown = true;
+   }
+   std::cout << "exception of a stage is rethrown by the thread pool executor: " << (rethrown ? "yes" : "no") << std::endl;
+   check &= rethrown && (input | scale | shift | square << throwing_pool) == expected;
+
+   std::cout << std::endl;
+
+   // Stream the data chunk by chunk through the stages. Only a single input
+   // and output chunk is allocated, independent of the size of the source.
+   std::size_t streamed_mismatches = 0;
+   std::size_t offset = 0;
+   auto const compare_chunk = [&](float const * chunk, std::size_t const n){
+      for(std::size_t i = 0; i < n; ++i){
+         streamed_mismatches += chunk[i] != expected[offset + i];
+      }
+      offset += n;
+   };
+   double const time_stream = measure([&]{
+      input | scale | shift | square << chunked(compare_chunk);
+   });
+   std::cout << "chunked stream of a vector: " << time_stream << " ms" << std::endl;
+   check &= streamed_mismatches == 0 && offset == pipeline_size;
+
+   // A generator does not know the number of elements in advance. The stream
+   // ends, if the generator returns std::nullopt.
+   std::size_t next = 0;
+   auto const counter = [&next]() -> std::optional<float> {
+      if(next == pipeline_size){
+         return std::nullopt;
+      }
+      return static_cast<float>(next++);
+   };
+   offset = 0;
+   std::size_t const streamed = from_generator(counter) | scale | shift | square << chunked(compare_chunk);
+   std::cout << "chunked stream of a generator: " << streamed << " elements" << std::endl;
+   check &= streamed_mismatches == 0 && streamed == pipeline_size;
+
+   // read values from a stream, e.g. a file
+   std::istringstream file("1 2 3 4 5 6");
+   MyVector<int> from_file;
+   auto const append = [&from_file](int const * chunk, std::size_t const n){
+      from_file.insert(from_file.end(), chunk, chunk + n);
+   };
+   from_istream<int>(file) | twice | increment << chunked(append);
+   std::cout << "from_istream(\"1 2 3 4 5 6\") | twice | increment: " << from_file << std::endl;
+   check &= from_file == MyVector<int>{3, 5, 7, 9, 11, 13};
+
+   std::cout << std::endl;
+
+   // parse -> transform -> aggregate: each stage runs on its own thread and
+   // the stateless transform stage is processed by two threads
+   constexpr std::size_t number_of_records = std::size_t{1} << 20;
+   MyVector<std::string> records(number_of_records);
+   for(std::size_t i = 0; i < number_of_records; ++i){
+      records[i] = std::to_string(i % 1000);
+   }
+   auto const parse = [](std::string const & record){ return std::stod(record); };
+   auto const transform = [](double const v){
+      double result = v;
+      for(int i = 0; i < 16; ++i){
+         result = std::sqrt(result + v);
+      }
+      return result;
+   };
+   double sum = 0.;
+   auto const aggregate = [&sum](double const v){ return sum += v; };
+
+   MyVector<double> expected_sums;
+   double const time_sequential = measure([&]{ expected_sums = records | parse | transform | aggregate << sequential; });
+   std::cout << "parse | transform | aggregate with sequential executor: " << time_sequential << " ms" << std::endl;
+
+   sum = 0.;
+   PipelinedExecutor pipelined;
+   MyVector<double> sums;
+   double const time_pipelined = measure([&]{ sums = records | parse | parallel_stage(transform, 2) | aggregate << pipelined; });
+   std::cout << "parse | transform | aggregate with pipelined executor: " << time_pipelined << " ms" << std::endl;
+   char const * stage_names[] = {"parse", "transform", "aggregate"};
+   for(std::size_t s = 0; s < pipelined.statistics().size(); ++s){
+      std::cout << "  " << stage_names[s] << ": " << pipelined.statistics()[s] << std::endl;
+   }
+   check &= sums == expected_sums;
+
+   // An exception of a stage cancels the run: the other threads drain their
+   // queues and stop, and the exception is rethrown on the calling thread.
+   auto const throw_at_record = [](double const v){
+      if(v == 999.){
+         throw std::runtime_error("stage failed");
+      }
+      return v;
+   };
+   bool pipelined_rethrown = false;
+   try{
+      MyVector<double> const output = records | parse | parallel_stage(throw_at_record, 2) | aggregate << pipelined;
+   }
+   catch(std::runtime_error const &){
+      pipelined_rethrown = true;
+   }
+   std::cout << "exception of a stage is rethrown by the pipelined executor: " << (pipelined_rethrown ? "yes" : "no") << std::endl;
+   sum = 0.;
+   check &= pipelined_rethrown && (records | parse | parallel_stage(transform, 2) | aggregate << pipelined) == expected_sums;
+
+   return check ? 0 : 1;
 }
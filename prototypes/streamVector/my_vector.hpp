@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template<typename TData>
+class MyVector : public std::vector<TData> {
+public:
+   MyVector() = default;
+   explicit MyVector(std::size_t size) : std::vector<TData>(size) {}
+   MyVector(std::initializer_list<TData> list) : std::vector<TData>(list) {}
+   MyVector(MyVector const & other) : std::vector<TData>(other) {}
+   MyVector(MyVector && other) noexcept : std::vector<TData>(std::move(other)) {}
+
+   MyVector & operator=(MyVector const & other) = default;
+   MyVector & operator=(MyVector && other) noexcept = default;
+
+   MyVector<TData> merge(MyVector<TData> const & other) const & {
+      MyVector<TData> merged(*this);
+      merged.reserve(merged.size() + other.size());
+      std::copy(other.begin(), other.end(), std::back_inserter(merged));
+      return merged;
+   }
+
+   /// @brief If the vector is a temporary, append other to the own buffer
+   /// instead of copying both vectors into a new one. other can be the vector
+   /// itself (`std::move(v) << v`): the memory is reserved before the
+   /// iterators of other are taken, therefore the appending does not
+   /// invalidate them. The capacity grows geometrically like push_back, so
+   /// that merging batches in a loop does not reallocate for each batch.
+   MyVector<TData> merge(MyVector<TData> const & other) && {
+      std::size_t const other_size = other.size();
+      std::size_t const required = this->size() + other_size;
+      if(required > this->capacity()){
+         this->reserve(std::max(required, 2 * this->capacity()));
+      }
+      std::copy_n(other.begin(), other_size, std::back_inserter(*this));
+      return std::move(*this);
+   }
+};
+
+// ####################################################################
+// lazy concatenation
+// ####################################################################
+
+template<typename TLeft, typename TRight>
+class Concat;
+
+template<typename T>
+struct is_concat : std::false_type {};
+
+template<typename TLeft, typename TRight>
+struct is_concat<Concat<TLeft, TRight>> : std::true_type {};
+
+/// @brief Expression template of `concat(left, right) << ...`. The node stores
+/// references to lvalue vectors and takes the ownership of rvalue vectors, so
+/// that no operand is copied before the result is materialized. The
+/// materialization sums the sizes of all operands, reserves the memory once
+/// and copies each element exactly once.
+///
+/// Lifetime: the node references its lvalue operands. It needs to be
+/// materialized before any of them is destroyed or modified, e.g. by
+/// converting it to MyVector in the same expression. Storing the node with
+/// `auto` is only safe, as long as the operands live.
+/// @tparam TLeft MyVector const &, MyVector or Concat
+/// @tparam TRight MyVector const & or MyVector
+template<typename TLeft, typename TRight>
+class [[nodiscard]] Concat {
+   TLeft m_left;
+   TRight m_right;
+
+   template<typename TNode>
+   static void append(std::vector<typename std::decay_t<TRight>::value_type> & out, TNode const & node){
+      if constexpr (is_concat<TNode>::value){
+         node.append_to(out);
+      } else {
+         out.insert(out.end(), node.begin(), node.end());
+      }
+   }
+
+public:
+   using value_type = typename std::decay_t<TRight>::value_type;
+
+   Concat(TLeft left, TRight right) : m_left(std::forward<TLeft>(left)), m_right(std::forward<TRight>(right)) {}
+
+   std::size_t size() const {
+      return m_left.size() + m_right.size();
+   }
+
+   void append_to(std::vector<value_type> & out) const {
+      append(out, m_left);
+      append(out, m_right);
+   }
+
+   MyVector<value_type> materialize() const {
+      MyVector<value_type> result;
+      result.reserve(size());
+      append_to(result);
+      return result;
+   }
+
+   operator MyVector<value_type>() const {
+      return materialize();
+   }
+};
+
+/// @brief Start a lazy concatenation, which is continued with `<< vector`
+/// and materialized with a single allocation. See Concat for the lifetime of
+/// the operands.
+template<typename TData>
+Concat<MyVector<TData> const &, MyVector<TData> const &> concat(MyVector<TData> const & v1, MyVector<TData> const & v2){
+   return {v1, v2};
+}
+
+template<typename TData>
+Concat<MyVector<TData> const &, MyVector<TData>> concat(MyVector<TData> const & v1, MyVector<TData> && v2){
+   return {v1, std::move(v2)};
+}
+
+// `v1 << v2` is eager and returns a MyVector, so that `auto v = v1 << v2`
+// does not reference its operands. In a chain `v1 << v2 << v3`, the result
+// of the first merge is an rvalue, therefore the following operands are
+// appended to its buffer.
+template<typename TData>
+MyVector<TData> operator<<(MyVector<TData> const & v1, MyVector<TData> const & v2){
+   return v1.merge(v2);
+}
+
+// rvalue << any vector: reuse the buffer of the left operand
+template<typename TData>
+MyVector<TData> operator<<(MyVector<TData> && v1, MyVector<TData> const & v2){
+   return std::move(v1).merge(v2);
+}
+
+template<typename TLeft, typename TRight, typename TData>
+Concat<Concat<TLeft, TRight>, MyVector<TData> const &> operator<<(Concat<TLeft, TRight> c, MyVector<TData> const & v){
+   return {std::move(c), v};
+}
+
+template<typename TLeft, typename TRight, typename TData>
+Concat<Concat<TLeft, TRight>, MyVector<TData>> operator<<(Concat<TLeft, TRight> c, MyVector<TData> && v){
+   return {std::move(c), std::move(v)};
+}
+
+template<typename T>
+std::ostream & operator<<(std::ostream & os, MyVector<T> const & vec){
+   os << "[";
+   for(auto i = 0; i < vec.size(); ++i){
+      os << vec[i];
+      if (i != vec.size() - 1){
+         os << ", ";
+      }
+   }
+   os << "]";
+   return os;
+}
+
+template<typename TLeft, typename TRight>
+std::ostream & operator<<(std::ostream & os, Concat<TLeft, TRight> const & c){
+   return os << c.materialize();
+}
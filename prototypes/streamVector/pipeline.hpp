@@ -0,0 +1,319 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "my_vector.hpp"
+
+// ####################################################################
+// Lazy pipeline: input | func1 | func2 << executor
+// ####################################################################
+//
+// `operator<<` binds stronger than `operator|`. Therefore
+// `input | func1 | func2 << executor` is parsed as
+// `(input | func1) | (func2 << executor)`:
+//   - `input | func1` creates a lazy Pipeline, which only stores the input and
+//     the function.
+//   - `func2 << executor` binds the last stage to the executor.
+//   - `Pipeline | BoundStage` composes all stages to a single function and
+//     runs it with the executor in a single pass over the input.
+// A pipeline without executor can be executed later with
+// `(input | func1 | func2) << executor`. Because the Pipeline stores a
+// reference of the input, it must not outlive the input.
+
+/// @brief Marks a type as executor, so that `func << executor` and
+/// `pipeline << executor` do not collide with other `operator<<`.
+template<typename T, typename = void>
+struct is_executor : std::false_type {};
+
+template<typename T>
+struct is_executor<T, std::void_t<typename T::executor_tag>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_executor_v = is_executor<std::decay_t<T>>::value;
+
+/// @brief Function, which applies first and afterwards second. The stages are
+/// fused to a single function, so that no intermediate vector is required.
+template<typename TFirst, typename TSecond>
+struct Compose {
+   TFirst first;
+   TSecond second;
+
+   template<typename T>
+   auto operator()(T && value) const {
+      return second(first(std::forward<T>(value)));
+   }
+};
+
+/// @brief Last stage of a pipeline, which is bound to an executor. The
+/// executor is stored as reference, if it is an lvalue (e.g. a thread pool),
+/// and as value, if it is a temporary.
+template<typename TFunc, typename TExecutor>
+struct BoundStage {
+   TFunc func;
+   TExecutor executor;
+};
+
+template<typename T>
+struct is_bound_stage : std::false_type {};
+
+template<typename TFunc, typename TExecutor>
+struct is_bound_stage<BoundStage<TFunc, TExecutor>> : std::true_type {};
+
+/// @brief Lazy pipeline of an input vector and the fused function of all
+/// stages. Nothing is executed until an executor is applied.
+template<typename TData, typename TFunc>
+class Pipeline {
+   MyVector<TData> const & m_input;
+   TFunc m_func;
+
+public:
+   using input_type = TData;
+   using output_type = std::decay_t<std::invoke_result_t<TFunc const &, TData const &>>;
+
+   Pipeline(MyVector<TData> const & input, TFunc func) : m_input(input), m_func(std::move(func)) {}
+
+   MyVector<TData> const & input() const {
+      return m_input;
+   }
+
+   TFunc const & func() const {
+      return m_func;
+   }
+};
+
+template<typename T>
+struct is_pipeline : std::false_type {};
+
+template<typename TData, typename TFunc>
+struct is_pipeline<Pipeline<TData, TFunc>> : std::true_type {};
+
+/// @brief input | func: create a lazy pipeline
+template<typename TData, typename TFunc,
+         typename = std::enable_if_t<std::is_invocable_v<TFunc const &, TData const &> && !is_bound_stage<std::decay_t<TFunc>>::value>>
+Pipeline<TData, std::decay_t<TFunc>> operator|(MyVector<TData> const & input, TFunc && func){
+   return {input, std::forward<TFunc>(func)};
+}
+
+/// @brief pipeline | func: append a stage
+template<typename TData, typename TFunc, typename TNext,
+         typename = std::enable_if_t<!is_bound_stage<std::decay_t<TNext>>::value>>
+Pipeline<TData, Compose<TFunc, std::decay_t<TNext>>> operator|(Pipeline<TData, TFunc> pipeline, TNext && next){
+   return {pipeline.input(), Compose<TFunc, std::decay_t<TNext>>{pipeline.func(), std::forward<TNext>(next)}};
+}
+
+/// @brief func << executor: bind the last stage to an executor
+template<typename TFunc, typename TExecutor,
+         typename = std::enable_if_t<is_executor_v<TExecutor> && !is_pipeline<std::decay_t<TFunc>>::value>>
+BoundStage<std::decay_t<TFunc>, TExecutor> operator<<(TFunc && func, TExecutor && executor){
+   return {std::forward<TFunc>(func), std::forward<TExecutor>(executor)};
+}
+
+/// @brief pipeline << executor: run the pipeline
+template<typename TData, typename TFunc, typename TExecutor,
+         typename = std::enable_if_t<is_executor_v<TExecutor>>>
+auto operator<<(Pipeline<TData, TFunc> const & pipeline, TExecutor && executor){
+   return executor.run(pipeline.input(), pipeline.func());
+}
+
+/// @brief pipeline | (func << executor): append the last stage and run the
+/// pipeline
+template<typename TData, typename TFunc, typename TLast, typename TExecutor>
+auto operator|(Pipeline<TData, TFunc> const & pipeline, BoundStage<TLast, TExecutor> bound){
+   return bound.executor.run(pipeline.input(), Compose<TFunc, TLast>{pipeline.func(), std::move(bound.func)});
+}
+
+/// @brief input | (func << executor): run a pipeline with a single stage
+template<typename TData, typename TFunc, typename TExecutor>
+auto operator|(MyVector<TData> const & input, BoundStage<TFunc, TExecutor> bound){
+   return bound.executor.run(input, bound.func);
+}
+
+template<typename TData, typename TFunc>
+using pipeline_output_t = std::decay_t<std::invoke_result_t<TFunc const &, TData const &>>;
+
+// ####################################################################
+// executors
+// ####################################################################
+
+/// @brief Run the fused stages element by element on the calling thread.
+struct SequentialExecutor {
+   using executor_tag = void;
+
+   template<typename TData, typename TFunc>
+   MyVector<pipeline_output_t<TData, TFunc>> run(MyVector<TData> const & input, TFunc const & func) const {
+      MyVector<pipeline_output_t<TData, TFunc>> output(input.size());
+      for(std::size_t i = 0; i < input.size(); ++i){
+         output[i] = func(input[i]);
+      }
+      return output;
+   }
+};
+
+/// @brief Run the fused stages in chunks of TWidth elements. The inner loop
+/// has a constant trip count and is marked with `#pragma omp simd`, so that
+/// the compiler vectorizes it without a runtime check of the loop length or
+/// of the aliasing of input and output. The pragma only needs -fopenmp-simd
+/// (no OpenMP runtime) and is ignored by compilers without support. The
+/// remaining elements are processed element by element.
+/// @tparam TWidth Number of elements of a chunk, e.g. the number of lanes of
+/// the widest SIMD register.
+template<std::size_t TWidth = 16>
+struct SimdChunkedExecutor {
+   using executor_tag = void;
+
+   template<typename TData, typename TFunc>
+   MyVector<pipeline_output_t<TData, TFunc>> run(MyVector<TData> const & input, TFunc const & func) const {
+      MyVector<pipeline_output_t<TData, TFunc>> output(input.size());
+      TData const * in = input.data();
+      auto * out = output.data();
+      std::size_t const vector_size = input.size() - input.size() % TWidth;
+
+      for(std::size_t i = 0; i < vector_size; i += TWidth){
+         #pragma omp simd
+         for(std::size_t lane = 0; lane < TWidth; ++lane){
+            out[i + lane] = func(in[i + lane]);
+         }
+      }
+      for(std::size_t i = vector_size; i < input.size(); ++i){
+         out[i] = func(in[i]);
+      }
+      return output;
+   }
+};
+
+/// @brief Persistent thread pool. The workers are started once and wait for
+/// work, so that the creation of threads is not part of each pipeline run.
+/// The input is split in chunks, which are claimed by the workers and the
+/// calling thread with an atomic counter.
+///
+/// The pool has a single task slot. Concurrent calls of run() or
+/// parallel_for() from different threads are serialized by m_run_mutex, so
+/// that one call cannot overwrite the task of another one. A task must not
+/// call parallel_for() of the same pool, which would deadlock.
+class ThreadPoolExecutor {
+   std::vector<std::thread> m_workers;
+   std::mutex m_run_mutex;
+   std::mutex m_mutex;
+   std::condition_variable m_cv_work;
+   std::condition_variable m_cv_done;
+   std::function<void(std::size_t)> const * m_task = nullptr;
+   std::size_t m_number_of_chunks = 0;
+   std::atomic<std::size_t> m_next_chunk{0};
+   std::size_t m_active_workers = 0;
+   std::size_t m_generation = 0;
+   bool m_stop = false;
+   std::exception_ptr m_exception;
+
+   void work(){
+      try{
+         for(std::size_t chunk = m_next_chunk++; chunk < m_number_of_chunks; chunk = m_next_chunk++){
+            (*m_task)(chunk);
+         }
+      }
+      catch(...){
+         // keep the first exception and skip the remaining chunks
+         std::lock_guard<std::mutex> lock(m_mutex);
+         if(!m_exception){
+            m_exception = std::current_exception();
+         }
+         m_next_chunk = m_number_of_chunks;
+      }
+   }
+
+   void worker_loop(){
+      std::size_t generation = 0;
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while(true){
+         m_cv_work.wait(lock, [&]{ return m_stop || m_generation != generation; });
+         if(m_stop){
+            return;
+         }
+         generation = m_generation;
+         lock.unlock();
+         work();
+         lock.lock();
+         if(--m_active_workers == 0){
+            m_cv_done.notify_one();
+         }
+      }
+   }
+
+public:
+   using executor_tag = void;
+
+   /// @brief Number of elements of a chunk. Large enough, that the overhead
+   /// of claiming a chunk is negligible.
+   static constexpr std::size_t chunk_size = 1 << 14;
+
+   explicit ThreadPoolExecutor(std::size_t const number_of_threads = std::thread::hardware_concurrency()){
+      // the calling thread is also a worker
+      for(std::size_t t = 1; t < std::max<std::size_t>(number_of_threads, 1); ++t){
+         m_workers.emplace_back([this]{ worker_loop(); });
+      }
+   }
+
+   ThreadPoolExecutor(ThreadPoolExecutor const &) = delete;
+   ThreadPoolExecutor & operator=(ThreadPoolExecutor const &) = delete;
+
+   ~ThreadPoolExecutor(){
+      {
+         std::lock_guard<std::mutex> lock(m_mutex);
+         m_stop = true;
+      }
+      m_cv_work.notify_all();
+      for(auto & worker : m_workers){
+         worker.join();
+      }
+   }
+
+   std::size_t number_of_threads() const {
+      return m_workers.size() + 1;
+   }
+
+   /// @brief Call task(chunk) for each chunk in [0, number_of_chunks) and
+   /// wait until all chunks are processed. Waits for a concurrent call of
+   /// another thread to finish first. If task throws, the remaining chunks
+   /// are skipped and the first exception is rethrown after all threads
+   /// stopped using task.
+   void parallel_for(std::size_t const number_of_chunks, std::function<void(std::size_t)> const & task){
+      std::lock_guard<std::mutex> const run_lock(m_run_mutex);
+      {
+         std::lock_guard<std::mutex> lock(m_mutex);
+         m_task = &task;
+         m_number_of_chunks = number_of_chunks;
+         m_next_chunk = 0;
+         m_active_workers = m_workers.size();
+         ++m_generation;
+      }
+      m_cv_work.notify_all();
+      work();
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv_done.wait(lock, [&]{ return m_active_workers == 0; });
+      if(m_exception){
+         std::rethrow_exception(std::exchange(m_exception, nullptr));
+      }
+   }
+
+   template<typename TData, typename TFunc>
+   MyVector<pipeline_output_t<TData, TFunc>> run(MyVector<TData> const & input, TFunc const & func){
+      MyVector<pipeline_output_t<TData, TFunc>> output(input.size());
+      std::size_t const number_of_chunks = (input.size() + chunk_size - 1) / chunk_size;
+      parallel_for(number_of_chunks, [&](std::size_t const chunk){
+         std::size_t const end = std::min(input.size(), (chunk + 1) * chunk_size);
+         for(std::size_t i = chunk * chunk_size; i < end; ++i){
+            output[i] = func(input[i]);
+         }
+      });
+      return output;
+   }
+};
@@ -0,0 +1,478 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "my_vector.hpp"
+#include "pipeline.hpp"
+#include "stream.hpp"
+
+// ####################################################################
+// Pipelined executor: each stage runs on its own thread(s)
+// ####################################################################
+//
+// The executor splits the fused function of a pipeline into its stages. Each
+// stage runs on its own thread and the stages are connected by bounded single
+// producer single consumer ring buffers, which transport batches of elements.
+// If a queue is full, the producing stage waits (backpressure), so that a fast
+// stage cannot allocate an unbounded amount of memory.
+//
+// A stateless stage can be processed by several threads with
+// `parallel_stage(func, threads)`. Batch k is sent to replica k % threads of
+// the next stage and each replica processes its batches in ascending order.
+// Therefore, each pair of producer and consumer replica has its own SPSC
+// queue and the order of the output is the order of the input.
+
+/// @brief Bounded lock-free ring buffer for a single producer and a single
+/// consumer thread. The counters are only written by one side and can be read
+/// after both threads are joined.
+template<typename TData>
+class SpscQueue {
+   std::vector<TData> m_slots;
+   // next slot to pop, written by the consumer
+   alignas(64) std::atomic<std::size_t> m_head{0};
+   // next slot to push, written by the producer
+   alignas(64) std::atomic<std::size_t> m_tail{0};
+   std::atomic<bool> m_closed{false};
+
+   // producer side counters
+   alignas(64) std::size_t m_pushes = 0;
+   std::size_t m_occupancy_sum = 0;
+   std::size_t m_blocked_pushes = 0;
+   // consumer side counters
+   alignas(64) std::size_t m_blocked_pops = 0;
+
+   bool try_push(TData & value){
+      std::size_t const tail = m_tail.load(std::memory_order_relaxed);
+      if(tail - m_head.load(std::memory_order_acquire) == m_slots.size()){
+         return false;
+      }
+      m_slots[tail % m_slots.size()] = std::move(value);
+      m_tail.store(tail + 1, std::memory_order_release);
+      return true;
+   }
+
+public:
+   explicit SpscQueue(std::size_t const capacity) : m_slots(std::max<std::size_t>(capacity, 1)) {}
+
+   std::size_t capacity() const {
+      return m_slots.size();
+   }
+
+   /// @brief Number of elements in the queue. Only a snapshot, if the other
+   /// side is running.
+   std::size_t size() const {
+      return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+   }
+
+   /// @brief Push value and wait, if the queue is full.
+   /// @return false, if the queue was closed by a failed run. The value is
+   /// dropped.
+   bool push(TData value){
+      if(m_closed.load(std::memory_order_acquire)){
+         return false;
+      }
+      m_occupancy_sum += size();
+      ++m_pushes;
+      if(!try_push(value)){
+         ++m_blocked_pushes;
+         while(!try_push(value)){
+            if(m_closed.load(std::memory_order_acquire)){
+               return false;
+            }
+            std::this_thread::yield();
+         }
+      }
+      return true;
+   }
+
+   /// @brief Signal the consumer, that no more values are pushed. Closing the
+   /// queue from another thread cancels the producer.
+   void close(){
+      m_closed.store(true, std::memory_order_release);
+   }
+
+   /// @brief Pop the next value and wait, if the queue is empty.
+   /// @return false, if the queue is closed and empty
+   bool pop(TData & value){
+      bool blocked = false;
+      while(true){
+         std::size_t const head = m_head.load(std::memory_order_relaxed);
+         if(head != m_tail.load(std::memory_order_acquire)){
+            value = std::move(m_slots[head % m_slots.size()]);
+            m_head.store(head + 1, std::memory_order_release);
+            m_blocked_pops += blocked;
+            return true;
+         }
+         // all values are pushed before the queue is closed, therefore the
+         // tail needs to be checked again after the close flag
+         if(m_closed.load(std::memory_order_acquire) && head == m_tail.load(std::memory_order_acquire)){
+            return false;
+         }
+         blocked = true;
+         std::this_thread::yield();
+      }
+   }
+
+   std::size_t pushes() const {
+      return m_pushes;
+   }
+
+   std::size_t occupancy_sum() const {
+      return m_occupancy_sum;
+   }
+
+   std::size_t blocked_pushes() const {
+      return m_blocked_pushes;
+   }
+
+   std::size_t blocked_pops() const {
+      return m_blocked_pops;
+   }
+};
+
+/// @brief Stateless stage, which is processed by several threads.
+template<typename TFunc>
+struct ParallelStage {
+   TFunc func;
+   std::size_t threads;
+
+   template<typename T>
+   auto operator()(T && value) const {
+      return func(std::forward<T>(value));
+   }
+};
+
+/// @brief Mark func as stateless, so that the PipelinedExecutor can process
+/// the stage with several threads. Other executors call func as usual.
+template<typename TFunc>
+ParallelStage<std::decay_t<TFunc>> parallel_stage(TFunc && func, std::size_t const threads){
+   return {std::forward<TFunc>(func), std::max<std::size_t>(threads, 1)};
+}
+
+/// @brief Counters of a single stage, which are collected during a run of the
+/// PipelinedExecutor.
+struct StageStatistics {
+   std::size_t threads = 0;
+   std::size_t elements = 0;
+   /// @brief Sum of the time, which all threads of the stage spent in the
+   /// stage function.
+   double busy_seconds = 0.;
+   /// @brief Number of batches, which waited for the previous stage.
+   std::size_t starved_batches = 0;
+   /// @brief Number of batches, which waited for space in the output queue.
+   std::size_t blocked_batches = 0;
+   /// @brief Average number of batches in the input queues of the stage. A
+   /// queue in front of the bottleneck stage is full most of the time.
+   double average_queue_occupancy = 0.;
+   std::size_t queue_capacity = 0;
+
+   /// @brief Elements per second, which the stage can process with all
+   /// threads. The stage with the lowest throughput limits the pipeline.
+   double throughput() const {
+      return busy_seconds > 0. ? elements * threads / busy_seconds : 0.;
+   }
+};
+
+inline std::ostream & operator<<(std::ostream & os, StageStatistics const & statistics){
+   os << statistics.threads << " threads, " << statistics.elements << " elements, "
+      << statistics.throughput() / 1e6 << " M elements/s, queue occupancy "
+      << statistics.average_queue_occupancy << "/" << statistics.queue_capacity
+      << ", starved " << statistics.starved_batches << ", blocked " << statistics.blocked_batches;
+   return os;
+}
+
+namespace detail {
+
+   /// @brief Split a fused function into the tuple of its stages.
+   template<typename TFunc>
+   std::tuple<TFunc> flatten_stages(TFunc const & func){
+      return std::tuple<TFunc>(func);
+   }
+
+   template<typename TFirst, typename TSecond>
+   auto flatten_stages(Compose<TFirst, TSecond> const & func){
+      return std::tuple_cat(flatten_stages(func.first), flatten_stages(func.second));
+   }
+
+   template<typename TFunc>
+   std::size_t stage_threads(TFunc const &){
+      return 1;
+   }
+
+   template<typename TFunc>
+   std::size_t stage_threads(ParallelStage<TFunc> const & stage){
+      return stage.threads;
+   }
+
+   template<typename T, typename TTuple>
+   struct tuple_prepend;
+
+   template<typename T, typename... Ts>
+   struct tuple_prepend<T, std::tuple<Ts...>> {
+      using type = std::tuple<T, Ts...>;
+   };
+
+   /// @brief Tuple of the input type of the first stage and the output types
+   /// of all stages.
+   template<typename TIn, typename TStages>
+   struct stage_types;
+
+   template<typename TIn>
+   struct stage_types<TIn, std::tuple<>> {
+      using type = std::tuple<TIn>;
+   };
+
+   template<typename TIn, typename TStage, typename... TStages>
+   struct stage_types<TIn, std::tuple<TStage, TStages...>> {
+      using type = typename tuple_prepend<TIn, typename stage_types<pipeline_output_t<TIn, TStage>, std::tuple<TStages...>>::type>::type;
+   };
+
+   /// @brief Queues between the replicas of two neighbouring stages. The queue
+   /// of batch k is queue(k % producers, k % consumers).
+   template<typename TData>
+   class Boundary {
+      std::size_t m_producers;
+      std::size_t m_consumers;
+      std::vector<std::unique_ptr<SpscQueue<std::vector<TData>>>> m_queues;
+
+   public:
+      Boundary(std::size_t const producers, std::size_t const consumers, std::size_t const capacity) : m_producers(producers), m_consumers(consumers){
+         for(std::size_t i = 0; i < producers * consumers; ++i){
+            m_queues.push_back(std::make_unique<SpscQueue<std::vector<TData>>>(capacity));
+         }
+      }
+
+      std::size_t producers() const {
+         return m_producers;
+      }
+
+      std::size_t consumers() const {
+         return m_consumers;
+      }
+
+      SpscQueue<std::vector<TData>> & queue(std::size_t const producer, std::size_t const consumer){
+         return *m_queues[producer * m_consumers + consumer];
+      }
+
+      /// @brief Close all queues of the producer.
+      void close(std::size_t const producer){
+         for(std::size_t consumer = 0; consumer < m_consumers; ++consumer){
+            queue(producer, consumer).close();
+         }
+      }
+
+      /// @brief Close the queues of all producers.
+      void close_all(){
+         for(auto & queue : m_queues){
+            queue->close();
+         }
+      }
+
+      /// @brief Pop batch k of the consumer.
+      bool pop(std::size_t const k, std::vector<TData> & batch){
+         return queue(k % m_producers, k % m_consumers).pop(batch);
+      }
+
+      /// @brief Push batch k of the producer.
+      /// @return false, if the run was cancelled
+      bool push(std::size_t const k, std::vector<TData> batch){
+         return queue(k % m_producers, k % m_consumers).push(std::move(batch));
+      }
+
+      std::vector<std::unique_ptr<SpscQueue<std::vector<TData>>>> const & queues() const {
+         return m_queues;
+      }
+   };
+
+   /// @brief Thread function of a single replica of a stage.
+   template<typename TIn, typename TOut, typename TFunc>
+   void run_stage(TFunc func, Boundary<TIn> & input, Boundary<TOut> & output, std::size_t const replica, StageStatistics & statistics){
+      std::vector<TIn> batch;
+      for(std::size_t k = replica; input.pop(k, batch); k += input.consumers()){
+         auto const start = std::chrono::steady_clock::now();
+         std::vector<TOut> result(batch.size());
+         for(std::size_t i = 0; i < batch.size(); ++i){
+            result[i] = func(batch[i]);
+         }
+         statistics.busy_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+         statistics.elements += batch.size();
+         if(!output.push(k, std::move(result))){
+            break;
+         }
+      }
+      output.close(replica);
+   }
+
+   template<typename TFunc>
+   TFunc const & unwrap_stage(TFunc const & func){
+      return func;
+   }
+
+   template<typename TFunc>
+   TFunc const & unwrap_stage(ParallelStage<TFunc> const & stage){
+      return stage.func;
+   }
+
+} // namespace detail
+
+/// @brief Run each stage of a pipeline on its own thread(s). The threads are
+/// started for each run. After a run, statistics() contains the counters of
+/// each stage. If a stage, the source or the collector throws, all queues are
+/// closed, so that the other threads drain and stop, and the first exception
+/// is rethrown after all threads are joined.
+class PipelinedExecutor {
+   std::size_t m_batch_size;
+   std::size_t m_queue_capacity;
+   std::vector<StageStatistics> m_statistics;
+
+   template<typename TTypes, typename TStages, typename TSource, std::size_t... I>
+   MyVector<std::tuple_element_t<sizeof...(I), TTypes>> run_stages(TSource & source, TStages const & stages, std::index_sequence<I...>){
+      using input_type = std::tuple_element_t<0, TTypes>;
+      using output_type = std::tuple_element_t<sizeof...(I), TTypes>;
+      constexpr std::size_t number_of_stages = sizeof...(I);
+
+      // replicas[0] is the source and replicas[number_of_stages + 1] the
+      // collector on the calling thread
+      std::array<std::size_t, number_of_stages + 2> const replicas{1, detail::stage_threads(std::get<I>(stages))..., 1};
+      std::tuple<detail::Boundary<std::tuple_element_t<I, TTypes>>..., detail::Boundary<output_type>> boundaries{
+         detail::Boundary<std::tuple_element_t<I, TTypes>>(replicas[I], replicas[I + 1], m_queue_capacity)...,
+         detail::Boundary<output_type>(replicas[number_of_stages], 1, m_queue_capacity)};
+
+      std::array<std::vector<StageStatistics>, number_of_stages> replica_statistics{std::vector<StageStatistics>(replicas[I + 1])...};
+      std::vector<std::thread> threads;
+
+      // The first exception of any thread is kept. Closing all queues cancels
+      // the run: producers stop pushing and consumers drain their queues.
+      std::mutex exception_mutex;
+      std::exception_ptr exception;
+      auto const guarded = [&](auto && body){
+         try{
+            body();
+         }
+         catch(...){
+            {
+               std::lock_guard<std::mutex> lock(exception_mutex);
+               if(!exception){
+                  exception = std::current_exception();
+               }
+            }
+            std::apply([](auto & ... boundary){ (boundary.close_all(), ...); }, boundaries);
+         }
+      };
+
+      MyVector<output_type> output;
+      // the calling thread is guarded too, so that the threads are joined, if
+      // starting a thread or collecting the output fails
+      guarded([&]{
+         threads.emplace_back([&]{
+            guarded([&]{
+               auto & boundary = std::get<0>(boundaries);
+               for(std::size_t k = 0;; ++k){
+                  std::vector<input_type> batch(m_batch_size);
+                  std::size_t const n = source.read(batch.data(), m_batch_size);
+                  if(n == 0){
+                     break;
+                  }
+                  batch.resize(n);
+                  if(!boundary.push(k, std::move(batch))){
+                     break;
+                  }
+               }
+               boundary.close(0);
+            });
+         });
+
+         auto const start_stage = [&](auto const index){
+            constexpr std::size_t i = decltype(index)::value;
+            for(std::size_t replica = 0; replica < replicas[i + 1]; ++replica){
+               threads.emplace_back([&, replica]{
+                  guarded([&]{
+                     detail::run_stage<std::tuple_element_t<i, TTypes>, std::tuple_element_t<i + 1, TTypes>>(
+                        detail::unwrap_stage(std::get<i>(stages)), std::get<i>(boundaries), std::get<i + 1>(boundaries), replica, replica_statistics[i][replica]);
+                  });
+               });
+            }
+         };
+         (start_stage(std::integral_constant<std::size_t, I>{}), ...);
+
+         auto & last = std::get<number_of_stages>(boundaries);
+         std::vector<output_type> batch;
+         for(std::size_t k = 0; last.pop(k, batch); ++k){
+            output.insert(output.end(), batch.begin(), batch.end());
+         }
+      });
+      for(auto & thread : threads){
+         thread.join();
+      }
+      if(exception){
+         std::rethrow_exception(exception);
+      }
+
+      m_statistics.assign(number_of_stages, StageStatistics{});
+      auto const collect = [&](auto const index){
+         constexpr std::size_t i = decltype(index)::value;
+         StageStatistics & statistics = m_statistics[i];
+         statistics.threads = replicas[i + 1];
+         for(StageStatistics const & replica : replica_statistics[i]){
+            statistics.elements += replica.elements;
+            statistics.busy_seconds += replica.busy_seconds;
+         }
+         std::size_t pushes = 0;
+         std::size_t occupancy_sum = 0;
+         for(auto const & queue : std::get<i>(boundaries).queues()){
+            pushes += queue->pushes();
+            occupancy_sum += queue->occupancy_sum();
+            statistics.starved_batches += queue->blocked_pops();
+         }
+         for(auto const & queue : std::get<i + 1>(boundaries).queues()){
+            statistics.blocked_batches += queue->blocked_pushes();
+         }
+         statistics.average_queue_occupancy = pushes > 0 ? static_cast<double>(occupancy_sum) / pushes : 0.;
+         statistics.queue_capacity = m_queue_capacity;
+      };
+      (collect(std::integral_constant<std::size_t, I>{}), ...);
+      return output;
+   }
+
+public:
+   using executor_tag = void;
+
+   /// @param batch_size Number of elements, which are transported as a single
+   /// queue entry.
+   /// @param queue_capacity Number of batches, which fit in the queue between
+   /// two threads.
+   explicit PipelinedExecutor(std::size_t const batch_size = 1024, std::size_t const queue_capacity = 8)
+      : m_batch_size(std::max<std::size_t>(batch_size, 1)), m_queue_capacity(queue_capacity) {}
+
+   /// @brief Counters of each stage of the last run.
+   std::vector<StageStatistics> const & statistics() const {
+      return m_statistics;
+   }
+
+   template<typename TSource, typename TFunc>
+   MyVector<pipeline_output_t<typename TSource::value_type, TFunc>> run_stream(TSource & source, TFunc const & func){
+      auto const stages = detail::flatten_stages(func);
+      using stages_type = std::decay_t<decltype(stages)>;
+      using types = typename detail::stage_types<typename TSource::value_type, stages_type>::type;
+      return run_stages<types>(source, stages, std::make_index_sequence<std::tuple_size_v<stages_type>>{});
+   }
+
+   template<typename TData, typename TFunc>
+   MyVector<pipeline_output_t<TData, TFunc>> run(MyVector<TData> const & input, TFunc const & func){
+      VectorSource<TData> source(input);
+      return run_stream(source, func);
+   }
+};
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "my_vector.hpp"
+#include "pipeline.hpp"
+
+// ####################################################################
+// Streaming: source | func1 | func2 << chunked(sink)
+// ####################################################################
+//
+// A source is read in chunks of a fixed number of bytes (16 KiB by default).
+// Each chunk is processed by the fused stages while it is still in the L1/L2
+// cache and afterwards passed to the sink. Only the input and the output
+// buffer of a single chunk are allocated, therefore the source can be larger
+// than the main memory or unbounded (e.g. a generator or a file).
+//
+// A source provides `using source_tag = void`, `value_type` and
+// `std::size_t read(value_type * buffer, std::size_t max)`, which returns the
+// number of read elements. 0 means, that the source is exhausted.
+
+template<typename T, typename = void>
+struct is_source : std::false_type {};
+
+template<typename T>
+struct is_source<T, std::void_t<typename T::source_tag>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_source_v = is_source<std::decay_t<T>>::value;
+
+/// @brief Read the elements of a vector.
+template<typename TData>
+class VectorSource {
+   MyVector<TData> const & m_input;
+   std::size_t m_position = 0;
+
+public:
+   using source_tag = void;
+   using value_type = TData;
+
+   explicit VectorSource(MyVector<TData> const & input) : m_input(input) {}
+
+   std::size_t read(TData * buffer, std::size_t const max){
+      std::size_t const n = std::min(max, m_input.size() - m_position);
+      std::copy_n(m_input.begin() + m_position, n, buffer);
+      m_position += n;
+      return n;
+   }
+};
+
+/// @brief Read elements from a generator, which returns std::optional. The
+/// source is exhausted, if the generator returns std::nullopt. The number of
+/// elements does not need to be known in advance.
+template<typename TGenerator>
+class GeneratorSource {
+   TGenerator m_generator;
+   bool m_exhausted = false;
+
+public:
+   using source_tag = void;
+   using value_type = typename std::invoke_result_t<TGenerator &>::value_type;
+
+   explicit GeneratorSource(TGenerator generator) : m_generator(std::move(generator)) {}
+
+   std::size_t read(value_type * buffer, std::size_t const max){
+      std::size_t n = 0;
+      while(!m_exhausted && n < max){
+         if(std::optional<value_type> value = m_generator()){
+            buffer[n++] = std::move(*value);
+         } else {
+            m_exhausted = true;
+         }
+      }
+      return n;
+   }
+};
+
+/// @brief Read whitespace separated values from an input stream, e.g. a
+/// std::ifstream.
+template<typename TData>
+class IstreamSource {
+   std::istream & m_stream;
+
+public:
+   using source_tag = void;
+   using value_type = TData;
+
+   explicit IstreamSource(std::istream & stream) : m_stream(stream) {}
+
+   std::size_t read(TData * buffer, std::size_t const max){
+      std::size_t n = 0;
+      while(n < max && m_stream >> buffer[n]){
+         ++n;
+      }
+      return n;
+   }
+};
+
+template<typename TData>
+VectorSource<TData> from_vector(MyVector<TData> const & input){
+   return VectorSource<TData>(input);
+}
+
+template<typename TGenerator>
+GeneratorSource<TGenerator> from_generator(TGenerator generator){
+   return GeneratorSource<TGenerator>(std::move(generator));
+}
+
+template<typename TData>
+IstreamSource<TData> from_istream(std::istream & stream){
+   return IstreamSource<TData>(stream);
+}
+
+/// @brief Lazy pipeline of a source and the fused function of all stages. The
+/// pipeline owns the source.
+template<typename TSource, typename TFunc>
+class StreamPipeline {
+   TSource m_source;
+   TFunc m_func;
+
+public:
+   StreamPipeline(TSource source, TFunc func) : m_source(std::move(source)), m_func(std::move(func)) {}
+
+   TSource & source(){
+      return m_source;
+   }
+
+   TFunc const & func() const {
+      return m_func;
+   }
+};
+
+// a stream pipeline is not a stage, which can be bound to an executor
+template<typename TSource, typename TFunc>
+struct is_pipeline<StreamPipeline<TSource, TFunc>> : std::true_type {};
+
+/// @brief source | func: create a lazy stream pipeline
+template<typename TSource, typename TFunc,
+         typename = std::enable_if_t<is_source_v<TSource> && !is_bound_stage<std::decay_t<TFunc>>::value>>
+StreamPipeline<std::decay_t<TSource>, std::decay_t<TFunc>> operator|(TSource && source, TFunc && func){
+   return {std::forward<TSource>(source), std::forward<TFunc>(func)};
+}
+
+/// @brief stream pipeline | func: append a stage
+template<typename TSource, typename TFunc, typename TNext,
+         typename = std::enable_if_t<!is_bound_stage<std::decay_t<TNext>>::value>>
+StreamPipeline<TSource, Compose<TFunc, std::decay_t<TNext>>> operator|(StreamPipeline<TSource, TFunc> pipeline, TNext && next){
+   return {std::move(pipeline.source()), Compose<TFunc, std::decay_t<TNext>>{pipeline.func(), std::forward<TNext>(next)}};
+}
+
+/// @brief stream pipeline << executor: run the pipeline
+template<typename TSource, typename TFunc, typename TExecutor,
+         typename = std::enable_if_t<is_executor_v<TExecutor>>>
+auto operator<<(StreamPipeline<TSource, TFunc> pipeline, TExecutor && executor){
+   return executor.run_stream(pipeline.source(), pipeline.func());
+}
+
+/// @brief stream pipeline | (func << executor): append the last stage and run
+/// the pipeline
+template<typename TSource, typename TFunc, typename TLast, typename TExecutor>
+auto operator|(StreamPipeline<TSource, TFunc> pipeline, BoundStage<TLast, TExecutor> bound){
+   return bound.executor.run_stream(pipeline.source(), Compose<TFunc, TLast>{pipeline.func(), std::move(bound.func)});
+}
+
+/// @brief source | (func << executor): run a stream pipeline with a single
+/// stage
+template<typename TSource, typename TFunc, typename TExecutor,
+         typename = std::enable_if_t<is_source_v<TSource>>>
+auto operator|(TSource && source, BoundStage<TFunc, TExecutor> bound){
+   return bound.executor.run_stream(source, bound.func);
+}
+
+/// @brief Default size of a chunk in bytes. The input and the output chunk
+/// fit together in the L1 cache of most CPUs.
+inline constexpr std::size_t default_chunk_bytes = 16 * 1024;
+
+/// @brief Run the fused stages chunk by chunk and pass each output chunk to
+/// the sink. The sink is called with a pointer to the output elements and the
+/// number of elements of the chunk.
+/// @tparam TSink function `void(TOut const *, std::size_t)`
+/// @tparam TChunkBytes size of a chunk in bytes
+template<typename TSink, std::size_t TChunkBytes = default_chunk_bytes>
+class ChunkedExecutor {
+   TSink m_sink;
+
+public:
+   using executor_tag = void;
+
+   explicit ChunkedExecutor(TSink sink) : m_sink(std::move(sink)) {}
+
+   /// @brief Number of elements of a chunk. Depends on the larger type of
+   /// input and output.
+   template<typename TIn, typename TOut>
+   static constexpr std::size_t chunk_size(){
+      return std::max<std::size_t>(1, TChunkBytes / std::max(sizeof(TIn), sizeof(TOut)));
+   }
+
+   /// @return Number of processed elements.
+   template<typename TSource, typename TFunc>
+   std::size_t run_stream(TSource & source, TFunc const & func){
+      using input_type = typename TSource::value_type;
+      using output_type = pipeline_output_t<input_type, TFunc>;
+      constexpr std::size_t size = chunk_size<input_type, output_type>();
+
+      std::vector<input_type> input(size);
+      std::vector<output_type> output(size);
+      std::size_t processed = 0;
+      for(std::size_t n = source.read(input.data(), size); n > 0; n = source.read(input.data(), size)){
+         for(std::size_t i = 0; i < n; ++i){
+            output[i] = func(input[i]);
+         }
+         m_sink(static_cast<output_type const *>(output.data()), n);
+         processed += n;
+      }
+      return processed;
+   }
+
+   /// @brief Stream a vector through the pipeline.
+   template<typename TData, typename TFunc>
+   std::size_t run(MyVector<TData> const & input, TFunc const & func){
+      VectorSource<TData> source(input);
+      return run_stream(source, func);
+   }
+};
+
+/// @brief Create a ChunkedExecutor with the default chunk size.
+template<typename TSink>
+ChunkedExecutor<TSink> chunked(TSink sink){
+   return ChunkedExecutor<TSink>(std::move(sink));
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The header requires only C++11, so that it can be used by all examples.
+
+/// @brief Result type of a task, which is created by submit(func, args...).
+/// The function and the arguments are stored as copies and called as lvalues,
+/// like std::bind does.
+template <typename TFunc, typename... TArgs>
+using task_result_t =
+    decltype(std::declval<typename std::decay<TFunc>::type &>()(
+        std::declval<typename std::decay<TArgs>::type &>()...));
+
+/// @brief Persistent thread pool with work stealing. The workers are started
+/// once, therefore submitting a task does not create a thread.
+///
+/// Each worker has its own task deque. A task, which is submitted by a worker
+/// (nested task), is pushed to the back of the deque of the worker and the
+/// worker pops its tasks from the back (LIFO), so that the data of the parent
+/// task is still in the cache. An idle worker steals the oldest task from the
+/// front of the deque of another worker. Tasks of other threads are
+/// distributed round robin to the deques.
+class ThreadPool {
+  using Task = std::function<void()>;
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  /// @brief Identifies the pool and the deque of the current thread.
+  struct WorkerContext {
+    ThreadPool const *pool = nullptr;
+    std::size_t index = 0;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+  std::vector<std::thread> m_workers;
+  std::mutex m_sleep_mutex;
+  std::condition_variable m_sleep_cv;
+  // number of tasks in all deques, only incremented with locked m_sleep_mutex
+  std::atomic<std::size_t> m_pending{0};
+  std::atomic<std::size_t> m_next_queue{0};
+  bool m_stop = false;
+
+  static WorkerContext &context() {
+    static thread_local WorkerContext worker_context;
+    return worker_context;
+  }
+
+  bool is_worker() const { return context().pool == this; }
+
+  void push(Task task) {
+    std::size_t const index =
+        is_worker() ? context().index : m_next_queue++ % m_queues.size();
+    {
+      // Increment before the push, so that a worker cannot pop the task before
+      // it is counted. A worker, which wakes up too early, tries again.
+      std::lock_guard<std::mutex> lock(m_sleep_mutex);
+      ++m_pending;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+      m_queues[index]->tasks.push_back(std::move(task));
+    }
+    m_sleep_cv.notify_one();
+  }
+
+  /// @brief Pop the newest task of the own deque or steal the oldest task of
+  /// another deque.
+  bool try_pop(std::size_t const index, Task &task) {
+    {
+      WorkerQueue &own = *m_queues[index];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        --m_pending;
+        return true;
+      }
+    }
+    for (std::size_t i = 1; i < m_queues.size(); ++i) {
+      WorkerQueue &victim = *m_queues[(index + i) % m_queues.size()];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        --m_pending;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void worker_loop(std::size_t const index) {
+    context().pool = this;
+    context().index = index;
+    while (true) {
+      Task task;
+      if (try_pop(index, task)) {
+        task();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(m_sleep_mutex);
+      m_sleep_cv.wait(lock, [this] { return m_stop || m_pending > 0; });
+      // the remaining tasks are processed before the pool is destroyed
+      if (m_stop && m_pending == 0) {
+        return;
+      }
+    }
+  }
+
+public:
+  explicit ThreadPool(std::size_t const number_of_threads =
+                          std::thread::hardware_concurrency()) {
+    std::size_t const size = std::max<std::size_t>(number_of_threads, 1);
+    for (std::size_t i = 0; i < size; ++i) {
+      m_queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue));
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      m_workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+  }
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  /// @brief Waits until all submitted tasks are processed.
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(m_sleep_mutex);
+      m_stop = true;
+    }
+    m_sleep_cv.notify_all();
+    for (std::thread &worker : m_workers) {
+      worker.join();
+    }
+  }
+
+  std::size_t size() const { return m_workers.size(); }
+
+  /// @brief Run func(args...) on a worker. func and args are copied, like
+  /// std::thread(func, args...) does, therefore each functor, which can be
+  /// started with std::thread, can be submitted.
+  /// @return Future of the result. An exception of the task is rethrown by
+  /// future.get().
+  template <typename TFunc, typename... TArgs>
+  std::future<task_result_t<TFunc, TArgs...>> submit(TFunc &&func,
+                                                     TArgs &&...args) {
+    using result_type = task_result_t<TFunc, TArgs...>;
+    std::shared_ptr<std::packaged_task<result_type()>> task =
+        std::make_shared<std::packaged_task<result_type()>>(std::bind(
+            std::forward<TFunc>(func), std::forward<TArgs>(args)...));
+    std::future<result_type> future = task->get_future();
+    push([task] { (*task)(); });
+    return future;
+  }
+
+  /// @brief Process a single pending task on the calling thread.
+  /// @return false, if no task is pending
+  bool run_pending_task() {
+    std::size_t const index = is_worker() ? context().index : 0;
+    Task task;
+    if (!try_pop(index, task)) {
+      return false;
+    }
+    task();
+    return true;
+  }
+
+  /// @brief Wait for the future and return its result. The calling thread
+  /// processes pending tasks in the meantime. Therefore, a task can wait for
+  /// its nested tasks without blocking a worker, even if all workers wait.
+  template <typename T> T wait(std::future<T> &future) {
+    while (future.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+      if (!run_pending_task()) {
+        std::this_thread::yield();
+      }
+    }
+    return future.get();
+  }
+
+  /// @brief Call func(i) for each i in [begin, end). The range is split
+  /// recursively in halves until a part has at most grain_size indices. The
+  /// second half is submitted as nested task, which can be stolen by an idle
+  /// worker, and the first half is processed by the calling thread.
+  /// @param grain_size Number of indices, which are processed by a single
+  /// task. Needs to be large enough, that the cost of a task is negligible.
+  template <typename TFunc>
+  void parallel_for(std::size_t const begin, std::size_t const end,
+                    TFunc const &func, std::size_t const grain_size = 1) {
+    if (end <= begin) {
+      return;
+    }
+    std::size_t const grain = std::max<std::size_t>(grain_size, 1);
+    if (end - begin <= grain) {
+      for (std::size_t i = begin; i < end; ++i) {
+        func(i);
+      }
+      return;
+    }
+    std::size_t const middle = begin + (end - begin) / 2;
+    std::future<void> second = submit([this, middle, end, &func, grain] {
+      parallel_for(middle, end, func, grain);
+    });
+    try {
+      parallel_for(begin, middle, func, grain);
+    } catch (...) {
+      // the nested task references func, therefore it needs to be finished
+      // before the exception leaves the function
+      try {
+        wait(second);
+      } catch (...) {
+      }
+      throw;
+    }
+    wait(second);
+  }
+};
@@ -0,0 +1,101 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+/// @brief Measure the runtime of func in microseconds.
+template <typename TFunc> double measure(TFunc func) {
+  auto const start = std::chrono::steady_clock::now();
+  func();
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+/// @brief Sum of [begin, end), computed by nested tasks.
+long long nested_sum(ThreadPool &pool, std::vector<int> const &data,
+                     std::size_t const begin, std::size_t const end) {
+  if (end - begin <= 1024) {
+    return std::accumulate(data.begin() + begin, data.begin() + end, 0LL);
+  }
+  std::size_t const middle = begin + (end - begin) / 2;
+  std::future<long long> second =
+      pool.submit(nested_sum, std::ref(pool), std::cref(data), middle, end);
+  long long const first = nested_sum(pool, data, begin, middle);
+  return first + pool.wait(second);
+}
+
+struct SmallJob {
+  int id;
+  std::vector<int> &results;
+
+  void operator()(int const factor) { results[id] = id * factor; }
+};
+
+int main(int argc, char **argv) {
+  ThreadPool pool;
+  std::cout << "thread pool with " << pool.size() << " threads\n";
+  bool check = true;
+
+  // many small jobs: a thread per job vs. the thread pool
+  int constexpr number_of_jobs = 10000;
+  std::vector<int> results_thread(number_of_jobs, 0);
+  std::vector<int> results_pool(number_of_jobs, 0);
+
+  double const time_thread = measure([&] {
+    for (int i = 0; i < number_of_jobs; ++i) {
+      std::thread t(SmallJob{i, results_thread}, 2);
+      t.join();
+    }
+  });
+
+  double const time_pool = measure([&] {
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < number_of_jobs; ++i) {
+      futures.push_back(pool.submit(SmallJob{i, results_pool}, 2));
+    }
+    for (std::future<void> &future : futures) {
+      future.get();
+    }
+  });
+
+  std::cout << "std::thread per job: " << time_thread / number_of_jobs
+            << " us per job\n";
+  std::cout << "thread pool: " << time_pool / number_of_jobs
+            << " us per job\n";
+  check = check && results_thread == results_pool;
+
+  // parallel_for with different grain sizes
+  std::size_t constexpr size = std::size_t{1} << 22;
+  std::vector<int> data(size, 0);
+  for (std::size_t grain_size : {std::size_t{1} << 8, std::size_t{1} << 14}) {
+    std::fill(data.begin(), data.end(), -1);
+    double const time = measure([&] {
+      pool.parallel_for(
+          0, size,
+          [&data](std::size_t const i) { data[i] = static_cast<int>(i % 7); },
+          grain_size);
+    });
+    std::cout << "parallel_for with grain size " << grain_size << ": "
+              << time << " us\n";
+    bool all_written = true;
+    for (std::size_t i = 0; i < size; ++i) {
+      all_written = all_written && data[i] == static_cast<int>(i % 7);
+    }
+    check = check && all_written;
+  }
+
+  // nested tasks wait for their children without blocking a worker
+  long long const expected = std::accumulate(data.begin(), data.end(), 0LL);
+  long long const sum = nested_sum(pool, data, 0, size);
+  std::cout << "nested sum: " << sum << " (expected " << expected << ")\n";
+  check = check && sum == expected;
+
+  return check ? 0 : 1;
+}